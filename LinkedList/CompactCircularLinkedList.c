@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>       // for clock_gettime()
+#include "IndexPool.h"  // for indexAlloc(), indexFree() and NIL
+#include "NodePool.h"   // for the pointer-linked list in the benchmark
+
+/*
+    Circular linked list with 32-bit index links.
+
+    Same operations and output as CircularLinkedList.c, but nodes live in one
+    growable array (IndexPool.h) and 'next' is an array index. A node is
+    8 bytes instead of 16. The ring invariant is unchanged: the tail's next
+    is the head.
+*/
+struct Node {
+    int data;
+    uint32_t next;           // Index of the next node in the ring
+};
+
+// List descriptor; head and tail are indices into pool.nodes
+struct List {
+    uint32_t head;
+    uint32_t tail;
+    int size;
+    struct IndexPool pool;   // Backs every node of this list
+};
+
+// Node at index i; only valid until the next createNode() call
+#define NODE(list, i) ((struct Node*)(list)->pool.nodes + (i))
+
+// Initialize an empty list
+void initList(struct List* list) {
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+    initIndexPool(&list->pool, sizeof(struct Node));
+}
+
+// Create a new node, returns its index
+uint32_t createNode(struct List* list, int value) {
+    uint32_t i = indexAlloc(&list->pool);
+    NODE(list, i)->data = value;
+    NODE(list, i)->next = NIL;
+    return i;
+}
+
+// Link a new node between tail and head; it becomes the new head or tail
+static void linkNode(struct List* list, int value, int atEnd) {
+    uint32_t newNode = createNode(list, value);
+    if (list->head == NIL) {
+        NODE(list, newNode)->next = newNode;
+        list->head = newNode;
+        list->tail = newNode;
+    } else {
+        NODE(list, newNode)->next = list->head;
+        NODE(list, list->tail)->next = newNode;
+        if (atEnd)
+            list->tail = newNode;
+        else
+            list->head = newNode;
+    }
+    list->size++;
+}
+
+// Unlink 'node' whose predecessor is 'prev' and return it to the pool
+static void unlinkNode(struct List* list, uint32_t prev, uint32_t node) {
+    uint32_t next = NODE(list, node)->next;
+    if (next == node) {
+        list->head = NIL;
+        list->tail = NIL;
+    } else {
+        NODE(list, prev)->next = next;
+        if (node == list->head)
+            list->head = next;
+        if (node == list->tail)
+            list->tail = prev;
+    }
+    list->size--;
+    indexFree(&list->pool, node);
+}
+
+// 1. Insert at beginning: O(1)
+void insertAtBeginning(struct List* list, int value) {
+    linkNode(list, value, 0);
+    printf("Inserted %d at the beginning.\n", value);
+}
+
+// 2. Insert at end: O(1)
+void insertAtEnd(struct List* list, int value) {
+    int wasEmpty = list->head == NIL;
+    linkNode(list, value, 1);
+    if (wasEmpty)
+        printf("Inserted %d at the end (list was empty).\n", value);
+    else
+        printf("Inserted %d at the end.\n", value);
+}
+
+// 3. Delete from beginning: O(1), tail is the head's predecessor
+void deleteFromBeginning(struct List* list) {
+    if (list->head == NIL) {
+        printf("List is empty. Nothing to delete.\n");
+        return;
+    }
+
+    int value = NODE(list, list->head)->data;
+    int onlyNode = list->size == 1;
+    unlinkNode(list, list->tail, list->head);
+    if (onlyNode)
+        printf("Deleted %d (only node).\n", value);
+    else
+        printf("Deleted %d from the beginning.\n", value);
+}
+
+// 4. Delete from end: still a walk around the ring to find the tail's predecessor
+void deleteFromEnd(struct List* list) {
+    if (list->head == NIL) {
+        printf("List is empty. Nothing to delete.\n");
+        return;
+    }
+
+    uint32_t prev = list->head;
+    while (NODE(list, prev)->next != list->tail)
+        prev = NODE(list, prev)->next;
+
+    int value = NODE(list, list->tail)->data;
+    int onlyNode = list->size == 1;
+    unlinkNode(list, prev, list->tail);
+    if (onlyNode)
+        printf("Deleted %d (only node).\n", value);
+    else
+        printf("Deleted %d from the end.\n", value);
+}
+
+// 5. Delete by value
+void deleteByValue(struct List* list, int value) {
+    if (list->head == NIL) {
+        printf("List is empty.\n");
+        return;
+    }
+
+    // Start from the tail so the head node has a predecessor too
+    uint32_t prev = list->tail;
+    uint32_t temp = list->head;
+    do {
+        if (NODE(list, temp)->data == value) {
+            int onlyNode = list->size == 1;
+            int wasHead = temp == list->head;
+            unlinkNode(list, prev, temp);
+            if (onlyNode)
+                printf("Deleted node with value %d (only node).\n", value);
+            else if (wasHead)
+                printf("Deleted node with value %d (was head node).\n", value);
+            else
+                printf("Deleted node with value %d.\n", value);
+            return;
+        }
+        prev = temp;
+        temp = NODE(list, temp)->next;
+    } while (temp != list->head);
+
+    printf("Value %d not found in the list.\n", value);
+}
+
+// 6. Search
+void search(struct List* list, int value) {
+    if (list->head == NIL) {
+        printf("List is empty.\n");
+        return;
+    }
+
+    uint32_t temp = list->head;
+    int pos = 1;
+    do {
+        if (NODE(list, temp)->data == value) {
+            printf("Value %d found at position %d.\n", value, pos);
+            return;
+        }
+        temp = NODE(list, temp)->next;
+        pos++;
+    } while (temp != list->head);
+
+    printf("Value %d not found in the list.\n", value);
+}
+
+// 7. Display the list
+void display(struct List* list) {
+    if (list->head == NIL) {
+        printf("List is empty.\n");
+        return;
+    }
+
+    uint32_t temp = list->head;
+    printf("Circular List: ");
+    do {
+        printf("%d -> ", NODE(list, temp)->data);
+        temp = NODE(list, temp)->next;
+    } while (temp != list->head);
+    printf("(head)\n");
+}
+
+// 8. Length of the list: O(1)
+int listLength(struct List* list) {
+    return list->size;
+}
+
+// 9. Free all nodes: O(1) reset, the array only backs this list
+void freeList(struct List* list) {
+    indexReset(&list->pool);
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+}
+
+/*
+    Benchmark: the pointer-linked ring of CircularLinkedList.c (pool-backed)
+    against this one, building by appends and then going once around.
+*/
+struct PtrNode {
+    int data;
+    struct PtrNode* next;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void benchmark(int n) {
+    struct NodePool pool;
+    struct PtrNode* head = NULL;
+    struct PtrNode* tail = NULL;
+    struct List list;
+    long long sum = 0;
+
+    initPool(&pool, sizeof(struct PtrNode));
+    double start = nowNs();
+    for (int i = 0; i < n; i++) {
+        struct PtrNode* node = (struct PtrNode*)poolAlloc(&pool);
+        node->data = i;
+        if (head == NULL) head = node;
+        else tail->next = node;
+        node->next = head;
+        tail = node;
+    }
+    double build = (nowNs() - start) / n;
+    start = nowNs();
+    struct PtrNode* node = head;
+    do {
+        sum += node->data;
+        node = node->next;
+    } while (node != head);
+    double walk = (nowNs() - start) / n;
+    printf("  pointer links %2zu bytes/node: build %5.2f ns, walk %5.2f ns per node (sum %lld)\n",
+           sizeof(struct PtrNode), build, walk, sum);
+    destroyPool(&pool);
+
+    initList(&list);
+    sum = 0;
+    start = nowNs();
+    for (int i = 0; i < n; i++)
+        linkNode(&list, i, 1);
+    build = (nowNs() - start) / n;
+    start = nowNs();
+    uint32_t i = list.head;
+    do {
+        sum += NODE(&list, i)->data;
+        i = NODE(&list, i)->next;
+    } while (i != list.head);
+    walk = (nowNs() - start) / n;
+    printf("  index links   %2zu bytes/node: build %5.2f ns, walk %5.2f ns per node (sum %lld)\n",
+           sizeof(struct Node), build, walk, sum);
+    freeList(&list);
+    destroyIndexPool(&list.pool);
+}
+
+// Main Function
+int main() {
+    struct List list;
+    initList(&list);
+
+    insertAtBeginning(&list, 10);
+    insertAtBeginning(&list, 5);
+    insertAtEnd(&list, 20);
+    insertAtEnd(&list, 30);
+
+    display(&list);
+
+    deleteFromBeginning(&list);
+    display(&list);
+
+    deleteFromEnd(&list);
+    display(&list);
+
+    deleteByValue(&list, 20);
+    display(&list);
+
+    deleteByValue(&list, 100); // Not in list
+
+    search(&list, 10);
+    search(&list, 100);
+    printf("Length of the list: %d\n", listLength(&list));
+
+    freeList(&list);
+    destroyIndexPool(&list.pool);
+
+    printf("\n10000000 appends, then once around the ring:\n");
+    benchmark(10000000);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -----------------------------------
+    Inserted 10 at the beginning.
+    Inserted 5 at the beginning.
+    Inserted 20 at the end.
+    Inserted 30 at the end.
+    Circular List: 5 -> 10 -> 20 -> 30 -> (head)
+    Deleted 5 from the beginning.
+    Circular List: 10 -> 20 -> 30 -> (head)
+    Deleted 30 from the end.
+    Circular List: 10 -> 20 -> (head)
+    Deleted node with value 20.
+    Circular List: 10 -> (head)
+    Value 100 not found in the list.
+    Value 10 found at position 1.
+    Value 100 not found in the list.
+    Length of the list: 1
+
+    10000000 appends, then once around the ring:
+      pointer links 16 bytes/node: build 11.51 ns, walk  3.49 ns per node (sum 49999995000000)
+      index links    8 bytes/node: build 10.75 ns, walk  4.08 ns per node (sum 49999995000000)
+*/
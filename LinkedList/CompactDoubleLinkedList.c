@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>       // for clock_gettime()
+#include "IndexPool.h"  // for indexAlloc(), indexFree() and NIL
+#include "NodePool.h"   // for the pointer-linked list in the benchmark
+
+/*
+    Doubly linked list with 32-bit index links.
+
+    Same operations and output as DoubleLinkedList.c, but nodes live in one
+    growable array (IndexPool.h) and 'prev'/'next' are array indices. A node
+    is 12 bytes instead of 24, so twice as many fit in each cache line.
+*/
+struct Node {
+    int data;
+    uint32_t prev;           // Index of the previous node, NIL at the head
+    uint32_t next;           // Index of the next node, NIL at the tail
+};
+
+// List descriptor; head and tail are indices into pool.nodes
+struct List {
+    uint32_t head;
+    uint32_t tail;
+    int size;
+    struct IndexPool pool;   // Backs every node of this list
+};
+
+// Node at index i; only valid until the next createNode() call
+#define NODE(list, i) ((struct Node*)(list)->pool.nodes + (i))
+
+// Initialize an empty list
+void initList(struct List* list) {
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+    initIndexPool(&list->pool, sizeof(struct Node));
+}
+
+// Function to create a new node, returns its index
+uint32_t createNode(struct List* list, int value) {
+    uint32_t i = indexAlloc(&list->pool);
+    NODE(list, i)->data = value;
+    NODE(list, i)->prev = NIL;
+    NODE(list, i)->next = NIL;
+    return i;
+}
+
+// Append without printing, shared by insertAtEnd() and bulk builds
+static void appendNode(struct List* list, int value) {
+    uint32_t newNode = createNode(list, value);
+    NODE(list, newNode)->prev = list->tail;
+    if (list->tail == NIL)
+        list->head = newNode;
+    else
+        NODE(list, list->tail)->next = newNode;
+    list->tail = newNode;
+    list->size++;
+}
+
+// Unlink a node in O(1) using its prev/next indices and return it to the pool
+static void unlinkNode(struct List* list, uint32_t node) {
+    uint32_t prev = NODE(list, node)->prev;
+    uint32_t next = NODE(list, node)->next;
+
+    if (prev == NIL)
+        list->head = next;
+    else
+        NODE(list, prev)->next = next;
+
+    if (next == NIL)
+        list->tail = prev;
+    else
+        NODE(list, next)->prev = prev;
+
+    list->size--;
+    indexFree(&list->pool, node);
+}
+
+// 1. Insert at beginning
+void insertAtBeginning(struct List* list, int value) {
+    uint32_t newNode = createNode(list, value);
+    NODE(list, newNode)->next = list->head;
+    if (list->head != NIL)
+        NODE(list, list->head)->prev = newNode;
+    else
+        list->tail = newNode;
+    list->head = newNode;
+    list->size++;
+    printf("Inserted %d at the beginning.\n", value);
+}
+
+// 2. Insert at end: O(1) through the tail index
+void insertAtEnd(struct List* list, int value) {
+    int wasEmpty = list->head == NIL;
+    appendNode(list, value);
+    if (wasEmpty)
+        printf("Inserted %d at the end (list was empty).\n", value);
+    else
+        printf("Inserted %d at the end.\n", value);
+}
+
+// 3. Delete from beginning
+void deleteFromBeginning(struct List* list) {
+    if (list->head == NIL) {
+        printf("List is empty. Nothing to delete.\n");
+        return;
+    }
+    int value = NODE(list, list->head)->data;
+    unlinkNode(list, list->head);
+    printf("Deleted %d from the beginning.\n", value);
+}
+
+// 4. Delete from end: O(1) through the tail index
+void deleteFromEnd(struct List* list) {
+    if (list->tail == NIL) {
+        printf("List is empty. Nothing to delete.\n");
+        return;
+    }
+    int value = NODE(list, list->tail)->data;
+    unlinkNode(list, list->tail);
+    printf("Deleted %d from the end.\n", value);
+}
+
+// 5. Delete by value
+void deleteByValue(struct List* list, int value) {
+    uint32_t temp = list->head;
+    while (temp != NIL && NODE(list, temp)->data != value)
+        temp = NODE(list, temp)->next;
+
+    if (temp == NIL) {
+        printf("Value %d not found in the list.\n", value);
+        return;
+    }
+    unlinkNode(list, temp);
+    printf("Deleted node with value %d.\n", value);
+}
+
+// 6. Search
+void search(struct List* list, int value) {
+    int pos = 1;
+    for (uint32_t temp = list->head; temp != NIL; temp = NODE(list, temp)->next, pos++) {
+        if (NODE(list, temp)->data == value) {
+            printf("Value %d found at position %d.\n", value, pos);
+            return;
+        }
+    }
+    printf("Value %d not found in the list.\n", value);
+}
+
+// 7. Display forward
+void displayForward(struct List* list) {
+    if (list->head == NIL) {
+        printf("List is empty.\n");
+        return;
+    }
+    printf("Forward: ");
+    for (uint32_t temp = list->head; temp != NIL; temp = NODE(list, temp)->next)
+        printf("%d <-> ", NODE(list, temp)->data);
+    printf("NULL\n");
+}
+
+// 8. Display backward (starts at the tail, no walk to the end)
+void displayBackward(struct List* list) {
+    if (list->tail == NIL) {
+        printf("List is empty.\n");
+        return;
+    }
+    printf("Backward: ");
+    for (uint32_t temp = list->tail; temp != NIL; temp = NODE(list, temp)->prev)
+        printf("%d <-> ", NODE(list, temp)->data);
+    printf("NULL\n");
+}
+
+// 9. Length of the list: O(1)
+int listLength(struct List* list) {
+    return list->size;
+}
+
+// 10. Free the list: O(1) reset, the array only backs this list
+void freeList(struct List* list) {
+    indexReset(&list->pool);
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+}
+
+/*
+    Benchmark: the pointer-linked list of DoubleLinkedList.c (pool-backed)
+    against this one, building by appends and then walking backward, which
+    uses the 'prev' links.
+*/
+struct PtrNode {
+    int data;
+    struct PtrNode* prev;
+    struct PtrNode* next;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void benchmark(int n) {
+    struct NodePool pool;
+    struct PtrNode* head = NULL;
+    struct PtrNode* tail = NULL;
+    struct List list;
+    long long sum = 0;
+
+    initPool(&pool, sizeof(struct PtrNode));
+    double start = nowNs();
+    for (int i = 0; i < n; i++) {
+        struct PtrNode* node = (struct PtrNode*)poolAlloc(&pool);
+        node->data = i;
+        node->prev = tail;
+        node->next = NULL;
+        if (tail == NULL) head = node;
+        else tail->next = node;
+        tail = node;
+    }
+    double build = (nowNs() - start) / n;
+    start = nowNs();
+    for (struct PtrNode* node = tail; node != NULL; node = node->prev)
+        sum += node->data;
+    double walk = (nowNs() - start) / n;
+    printf("  pointer links %2zu bytes/node: build %5.2f ns, walk %5.2f ns per node (sum %lld)\n",
+           sizeof(struct PtrNode), build, walk, sum);
+    destroyPool(&pool);
+    (void)head;
+
+    initList(&list);
+    sum = 0;
+    start = nowNs();
+    for (int i = 0; i < n; i++)
+        appendNode(&list, i);
+    build = (nowNs() - start) / n;
+    start = nowNs();
+    for (uint32_t i = list.tail; i != NIL; i = NODE(&list, i)->prev)
+        sum += NODE(&list, i)->data;
+    walk = (nowNs() - start) / n;
+    printf("  index links   %2zu bytes/node: build %5.2f ns, walk %5.2f ns per node (sum %lld)\n",
+           sizeof(struct Node), build, walk, sum);
+    freeList(&list);
+    destroyIndexPool(&list.pool);
+}
+
+// Main Function
+int main() {
+    struct List list;
+    initList(&list);
+
+    insertAtBeginning(&list, 10);
+    insertAtBeginning(&list, 5);
+    insertAtEnd(&list, 20);
+    insertAtEnd(&list, 30);
+
+    displayForward(&list);
+    displayBackward(&list);
+
+    deleteFromBeginning(&list);
+    displayForward(&list);
+
+    deleteFromEnd(&list);
+    displayForward(&list);
+
+    deleteByValue(&list, 20);
+    displayForward(&list);
+
+    deleteByValue(&list, 100); // not in list
+
+    search(&list, 10);
+    search(&list, 100);
+    printf("Length of the list: %d\n", listLength(&list));
+
+    freeList(&list);
+    destroyIndexPool(&list.pool);
+
+    printf("\n10000000 appends, then one backward traversal:\n");
+    benchmark(10000000);
+    return 0;
+}
+
+/*
+    output (timings depend on the machine):
+    ----------------------------------
+    Inserted 10 at the beginning.
+    Inserted 5 at the beginning.
+    Inserted 20 at the end.
+    Inserted 30 at the end.
+    Forward: 5 <-> 10 <-> 20 <-> 30 <-> NULL
+    Backward: 30 <-> 20 <-> 10 <-> 5 <-> NULL
+    Deleted 5 from the beginning.
+    Forward: 10 <-> 20 <-> 30 <-> NULL
+    Deleted 30 from the end.
+    Forward: 10 <-> 20 <-> NULL
+    Deleted node with value 20.
+    Forward: 10 <-> NULL
+    Value 100 not found in the list.
+    Value 10 found at position 1.
+    Value 100 not found in the list.
+    Length of the list: 1
+
+    10000000 appends, then one backward traversal:
+      pointer links 24 bytes/node: build 16.99 ns, walk  5.04 ns per node (sum 49999995000000)
+      index links   12 bytes/node: build 12.43 ns, walk  4.52 ns per node (sum 49999995000000)
+*/
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>       // for clock_gettime()
+#include "IndexPool.h"  // for indexAlloc(), indexFree() and NIL
+#include "NodePool.h"   // for the pointer-linked list in the benchmark
+
+/*
+    Singly linked list with 32-bit index links.
+
+    Same operations and output as SinglyLinkedList.c, but nodes live in one
+    growable array (IndexPool.h) and 'next' is an array index. A node is
+    8 bytes instead of 16, and a list built by appends is laid out in order.
+*/
+struct Node {
+    int data;
+    uint32_t next;           // Index of the next node, NIL at the end
+};
+
+// List descriptor; head and tail are indices into pool.nodes
+struct List {
+    uint32_t head;
+    uint32_t tail;
+    int size;
+    struct IndexPool pool;   // Backs every node of this list
+};
+
+// Node at index i; only valid until the next createNode() call
+#define NODE(list, i) ((struct Node*)(list)->pool.nodes + (i))
+
+// Initialize an empty list
+void initList(struct List* list) {
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+    initIndexPool(&list->pool, sizeof(struct Node));
+}
+
+// Function to create a new node, returns its index
+uint32_t createNode(struct List* list, int value) {
+    uint32_t i = indexAlloc(&list->pool);
+    NODE(list, i)->data = value;
+    NODE(list, i)->next = NIL;
+    return i;
+}
+
+// Append without printing, shared by insertAtEnd() and bulk builds
+static void appendNode(struct List* list, int value) {
+    uint32_t newNode = createNode(list, value);
+    if (list->tail == NIL)
+        list->head = newNode;
+    else
+        NODE(list, list->tail)->next = newNode;
+    list->tail = newNode;
+    list->size++;
+}
+
+// 1. Insert at the beginning
+void insertAtBeginning(struct List* list, int value) {
+    uint32_t newNode = createNode(list, value);
+    NODE(list, newNode)->next = list->head;
+    list->head = newNode;
+    if (list->tail == NIL)
+        list->tail = newNode;
+    list->size++;
+    printf("Inserted %d at the beginning.\n", value);
+}
+
+// 2. Insert at the end: O(1) through the tail index
+void insertAtEnd(struct List* list, int value) {
+    int wasEmpty = list->head == NIL;
+    appendNode(list, value);
+    if (wasEmpty)
+        printf("Inserted %d at the end (list was empty).\n", value);
+    else
+        printf("Inserted %d at the end.\n", value);
+}
+
+// 3. Insert after a given value
+void insertAfterValue(struct List* list, int afterValue, int newValue) {
+    uint32_t temp = list->head;
+    while (temp != NIL && NODE(list, temp)->data != afterValue)
+        temp = NODE(list, temp)->next;
+    if (temp == NIL) {
+        printf("Value %d not found in the list.\n", afterValue);
+        return;
+    }
+    uint32_t newNode = createNode(list, newValue);  // May move the array, 'temp' stays valid
+    NODE(list, newNode)->next = NODE(list, temp)->next;
+    NODE(list, temp)->next = newNode;
+    if (list->tail == temp)
+        list->tail = newNode;
+    list->size++;
+    printf("Inserted %d after %d.\n", newValue, afterValue);
+}
+
+// 4. Delete a node by value
+void deleteNode(struct List* list, int value) {
+    uint32_t temp = list->head;
+    uint32_t prev = NIL;
+
+    while (temp != NIL && NODE(list, temp)->data != value) {
+        prev = temp;
+        temp = NODE(list, temp)->next;
+    }
+    if (temp == NIL) {
+        printf("Value %d not found in the list.\n", value);
+        return;
+    }
+
+    if (prev == NIL)
+        list->head = NODE(list, temp)->next;
+    else
+        NODE(list, prev)->next = NODE(list, temp)->next;
+    if (list->tail == temp)
+        list->tail = prev;
+    list->size--;
+    indexFree(&list->pool, temp);
+    if (prev == NIL)
+        printf("Deleted node with value %d (was head node).\n", value);
+    else
+        printf("Deleted node with value %d.\n", value);
+}
+
+// 5. Search for an element
+void searchNode(struct List* list, int value) {
+    int position = 1;
+    for (uint32_t temp = list->head; temp != NIL; temp = NODE(list, temp)->next, position++) {
+        if (NODE(list, temp)->data == value) {
+            printf("Value %d found at position %d.\n", value, position);
+            return;
+        }
+    }
+    printf("Value %d not found in the list.\n", value);
+}
+
+// 6. Display the linked list
+void displayList(struct List* list) {
+    if (list->head == NIL) {
+        printf("The list is empty.\n");
+        return;
+    }
+    printf("Linked List: ");
+    for (uint32_t temp = list->head; temp != NIL; temp = NODE(list, temp)->next)
+        printf("%d -> ", NODE(list, temp)->data);
+    printf("NULL\n");
+}
+
+// 7. Length of the list: O(1)
+int listLength(struct List* list) {
+    return list->size;
+}
+
+// 8. Free all nodes (cleanup): O(1) reset, the array only backs this list
+void freeList(struct List* list) {
+    indexReset(&list->pool);
+    list->head = NIL;
+    list->tail = NIL;
+    list->size = 0;
+}
+
+/*
+    Benchmark: the pointer-linked list of SinglyLinkedList.c (pool-backed)
+    against this one, building by appends and then summing every value.
+*/
+struct PtrNode {
+    int data;
+    struct PtrNode* next;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void benchmark(int n) {
+    struct NodePool pool;
+    struct PtrNode* head = NULL;
+    struct PtrNode* tail = NULL;
+    struct List list;
+    long long sum = 0;
+
+    initPool(&pool, sizeof(struct PtrNode));
+    double start = nowNs();
+    for (int i = 0; i < n; i++) {
+        struct PtrNode* node = (struct PtrNode*)poolAlloc(&pool);
+        node->data = i;
+        node->next = NULL;
+        if (tail == NULL) head = node;
+        else tail->next = node;
+        tail = node;
+    }
+    double build = (nowNs() - start) / n;
+    start = nowNs();
+    for (struct PtrNode* node = head; node != NULL; node = node->next)
+        sum += node->data;
+    double walk = (nowNs() - start) / n;
+    printf("  pointer links %2zu bytes/node: build %5.2f ns, walk %5.2f ns per node (sum %lld)\n",
+           sizeof(struct PtrNode), build, walk, sum);
+    destroyPool(&pool);
+
+    initList(&list);
+    sum = 0;
+    start = nowNs();
+    for (int i = 0; i < n; i++)
+        appendNode(&list, i);
+    build = (nowNs() - start) / n;
+    start = nowNs();
+    for (uint32_t i = list.head; i != NIL; i = NODE(&list, i)->next)
+        sum += NODE(&list, i)->data;
+    walk = (nowNs() - start) / n;
+    printf("  index links   %2zu bytes/node: build %5.2f ns, walk %5.2f ns per node (sum %lld)\n",
+           sizeof(struct Node), build, walk, sum);
+    freeList(&list);
+    destroyIndexPool(&list.pool);
+}
+
+// Main function to test all operations
+int main() {
+    struct List list;
+    initList(&list);
+
+    insertAtBeginning(&list, 10);
+    insertAtBeginning(&list, 5);
+    insertAtEnd(&list, 20);
+    insertAtEnd(&list, 30);
+    displayList(&list);
+
+    insertAfterValue(&list, 10, 15);
+    displayList(&list);
+
+    deleteNode(&list, 5);
+    displayList(&list);
+
+    deleteNode(&list, 20);
+    displayList(&list);
+
+    searchNode(&list, 15);
+    searchNode(&list, 100);
+    printf("Length of the list: %d\n", listLength(&list));
+
+    freeList(&list);
+    destroyIndexPool(&list.pool);
+
+    printf("\n10000000 appends, then one full traversal:\n");
+    benchmark(10000000);
+    return 0;
+}
+
+/*
+    program output (timings depend on the machine):
+    ------------------------
+    Inserted 10 at the beginning.
+    Inserted 5 at the beginning.
+    Inserted 20 at the end.
+    Inserted 30 at the end.
+    Linked List: 5 -> 10 -> 20 -> 30 -> NULL
+    Inserted 15 after 10.
+    Linked List: 5 -> 10 -> 15 -> 20 -> 30 -> NULL
+    Deleted node with value 5 (was head node).
+    Linked List: 10 -> 15 -> 20 -> 30 -> NULL
+    Deleted node with value 20.
+    Linked List: 10 -> 15 -> 30 -> NULL
+    Value 15 found at position 2.
+    Value 100 not found in the list.
+    Length of the list: 3
+
+    10000000 appends, then one full traversal:
+      pointer links 16 bytes/node: build 11.76 ns, walk  3.38 ns per node (sum 49999995000000)
+      index links    8 bytes/node: build  9.80 ns, walk  3.40 ns per node (sum 49999995000000)
+*/
@@ -0,0 +1,93 @@
+#ifndef INDEX_POOL_H
+#define INDEX_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>    // for uint32_t
+
+/*
+    Growable node array for the compact (index-linked) list programs.
+
+    All nodes of a list live in one contiguous array and link to each other
+    by 32-bit array index instead of by pointer. An index is half the size of
+    a pointer on 64-bit targets, nodes sit next to each other in memory, and
+    because links are positions rather than addresses the array can be grown
+    with realloc() without fixing up a single link.
+
+    The catch: a struct Node* into the array is only valid until the next
+    indexAlloc(), which may move the array. Hold indices, not pointers,
+    across allocations.
+
+    Freed nodes go on a free list threaded through their first 4 bytes.
+    indexReset() forgets every node at once in O(1) and keeps the array;
+    destroyIndexPool() releases it.
+
+    Usage:
+        struct IndexPool pool;
+        initIndexPool(&pool, sizeof(struct Node));
+        uint32_t i = indexAlloc(&pool);
+        struct Node* n = (struct Node*)pool.nodes + i;
+        indexFree(&pool, i);
+        destroyIndexPool(&pool);
+*/
+
+#define NIL UINT32_MAX           // "No node", the index version of NULL
+#define INDEX_POOL_INITIAL 16    // Nodes in the first array
+
+struct IndexPool {
+    char* nodes;                 // Node array, nodeSize bytes per node
+    uint32_t nodeSize;           // Bytes per node, at least 4
+    uint32_t capacity;           // Nodes the array can hold
+    uint32_t used;               // Nodes ever handed out since the last reset
+    uint32_t freeList;           // First node returned by indexFree(), or NIL
+};
+
+static inline void initIndexPool(struct IndexPool* pool, size_t nodeSize) {
+    pool->nodes = NULL;
+    pool->nodeSize = (uint32_t)nodeSize;
+    pool->capacity = 0;
+    pool->used = 0;
+    pool->freeList = NIL;
+}
+
+// Allocate one node and return its index: free list first, then the end of the array
+static inline uint32_t indexAlloc(struct IndexPool* pool) {
+    if (pool->freeList != NIL) {
+        uint32_t i = pool->freeList;
+        pool->freeList = *(uint32_t*)(pool->nodes + (size_t)i * pool->nodeSize);
+        return i;
+    }
+    if (pool->used == pool->capacity) {
+        // Doubling past 2^31 nodes would overflow the index (NIL is reserved)
+        uint32_t capacity = pool->capacity ? pool->capacity * 2 : INDEX_POOL_INITIAL;
+        char* nodes = pool->capacity > NIL / 2 ? NULL :
+                      (char*)realloc(pool->nodes, (size_t)capacity * pool->nodeSize);
+        if (nodes == NULL) {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+        pool->nodes = nodes;
+        pool->capacity = capacity;
+    }
+    return pool->used++;
+}
+
+// Return one node to the pool
+static inline void indexFree(struct IndexPool* pool, uint32_t i) {
+    *(uint32_t*)(pool->nodes + (size_t)i * pool->nodeSize) = pool->freeList;
+    pool->freeList = i;
+}
+
+// Drop every node in O(1); the array stays allocated for reuse
+static inline void indexReset(struct IndexPool* pool) {
+    pool->used = 0;
+    pool->freeList = NIL;
+}
+
+// Release the array
+static inline void destroyIndexPool(struct IndexPool* pool) {
+    free(pool->nodes);
+    initIndexPool(pool, pool->nodeSize);
+}
+
+#endif // INDEX_POOL_H
@@ -0,0 +1,393 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>    // for uint32_t
+#include <string.h>    // for memset()
+#include <time.h>      // for clock_gettime()
+#include "NodePool.h"  // for poolAlloc() and poolFree()
+#include "OpenAddressing.h"  // for homeSlot() and probeRemove()
+
+#define INITIAL_BUCKETS 16  // Hash table size, must be a power of two
+
+/*
+    Indexed doubly linked list.
+
+    The list keeps insertion order exactly like DoubleLinkedList.c. Next to
+    it an open-addressing hash table (linear probing) maps each value to the
+    nodes that hold it, so search and delete-by-value find their node in O(1)
+    instead of walking the list, and prev/next unlink it in O(1).
+
+    Duplicates: every table entry points at the first and last node with its
+    value, and nodes with equal values are chained through sameNext/samePrev
+    in list order. deleteByValue() removes the first occurrence, like the
+    linear version does.
+
+    Insertions happen at either end only, which keeps each duplicate chain in
+    list order without searching for neighbours.
+*/
+struct Node {
+    int data;
+    struct Node* prev;
+    struct Node* next;
+    struct Node* samePrev;   // Previous node with the same value
+    struct Node* sameNext;   // Next node with the same value
+};
+
+struct Bucket {
+    int used;
+    int key;
+    int count;               // Nodes holding 'key'
+    struct Node* first;
+    struct Node* last;
+};
+
+struct IndexedList {
+    struct Node* head;
+    struct Node* tail;
+    int size;
+    struct Bucket* buckets;
+    uint32_t mask;           // Bucket count - 1
+    int shift;               // 32 - log2(bucket count)
+    uint32_t usedBuckets;
+    struct NodePool pool;
+};
+
+static uint32_t hashValue(int key) {
+    // Fibonacci hashing spreads consecutive keys over the table
+    return (uint32_t)key * 2654435769u;
+}
+
+// Home bucket of 'key': the top bits of the product are the well-mixed ones
+static uint32_t homeBucket(const struct IndexedList* list, int key) {
+    return homeSlot(hashValue(key), list->shift);
+}
+
+void initList(struct IndexedList* list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->mask = INITIAL_BUCKETS - 1;
+    list->shift = hashShift(INITIAL_BUCKETS);
+    list->usedBuckets = 0;
+    list->buckets = (struct Bucket*)calloc(INITIAL_BUCKETS, sizeof(struct Bucket));
+    if (list->buckets == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    initPool(&list->pool, sizeof(struct Node));
+}
+
+// Find the bucket for 'key', or the empty bucket where it would go
+static struct Bucket* findBucket(struct IndexedList* list, int key) {
+    uint32_t i = homeBucket(list, key);
+    while (list->buckets[i].used && list->buckets[i].key != key)
+        i = (i + 1) & list->mask;
+    return &list->buckets[i];
+}
+
+// Double the table and reinsert every entry
+static void growTable(struct IndexedList* list) {
+    struct Bucket* old = list->buckets;
+    uint32_t oldCount = list->mask + 1;
+
+    list->buckets = (struct Bucket*)calloc(oldCount * 2, sizeof(struct Bucket));
+    if (list->buckets == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    list->mask = oldCount * 2 - 1;
+    list->shift--;
+    for (uint32_t i = 0; i < oldCount; i++)
+        if (old[i].used)
+            *findBucket(list, old[i].key) = old[i];
+    free(old);
+}
+
+// probeRemove() callbacks: 'table' is the list
+static uint32_t bucketHome(const void* table, uint32_t i) {
+    const struct IndexedList* list = (const struct IndexedList*)table;
+    return list->buckets[i].used ? homeBucket(list, list->buckets[i].key) : PROBE_EMPTY;
+}
+
+static void moveBucket(void* table, uint32_t to, uint32_t from) {
+    struct IndexedList* list = (struct IndexedList*)table;
+    list->buckets[to] = list->buckets[from];
+}
+
+// Remove a bucket, shifting later probes back so lookups never hit a hole
+static void removeBucket(struct IndexedList* list, struct Bucket* bucket) {
+    uint32_t hole = (uint32_t)(bucket - list->buckets);
+    list->buckets[probeRemove(list, list->mask, hole, bucketHome, moveBucket)].used = 0;
+    list->usedBuckets--;
+}
+
+// Create a node and register it in the index, at the front or back of its duplicates
+static struct Node* createNode(struct IndexedList* list, int value, int atEnd) {
+    if ((list->usedBuckets + 1) * 2 > list->mask + 1)
+        growTable(list);
+
+    struct Node* newNode = (struct Node*)poolAlloc(&list->pool);
+    struct Bucket* bucket = findBucket(list, value);
+    newNode->data = value;
+    newNode->prev = NULL;
+    newNode->next = NULL;
+    newNode->samePrev = NULL;
+    newNode->sameNext = NULL;
+
+    if (!bucket->used) {
+        bucket->used = 1;
+        bucket->key = value;
+        bucket->count = 0;
+        bucket->first = bucket->last = newNode;
+        list->usedBuckets++;
+    } else if (atEnd) {
+        newNode->samePrev = bucket->last;
+        bucket->last->sameNext = newNode;
+        bucket->last = newNode;
+    } else {
+        newNode->sameNext = bucket->first;
+        bucket->first->samePrev = newNode;
+        bucket->first = newNode;
+    }
+    bucket->count++;
+    list->size++;
+    return newNode;
+}
+
+// Unlink a node from the list and the index in O(1)
+static void unlinkNode(struct IndexedList* list, struct Node* node) {
+    struct Bucket* bucket = findBucket(list, node->data);
+
+    if (node->prev == NULL) list->head = node->next;
+    else node->prev->next = node->next;
+    if (node->next == NULL) list->tail = node->prev;
+    else node->next->prev = node->prev;
+
+    if (node->samePrev == NULL) bucket->first = node->sameNext;
+    else node->samePrev->sameNext = node->sameNext;
+    if (node->sameNext == NULL) bucket->last = node->samePrev;
+    else node->sameNext->samePrev = node->samePrev;
+
+    if (--bucket->count == 0)
+        removeBucket(list, bucket);
+    list->size--;
+    poolFree(&list->pool, node);
+}
+
+// Append without printing, shared by insertAtEnd() and bulk builds
+static void appendNode(struct IndexedList* list, int value) {
+    struct Node* newNode = createNode(list, value, 1);
+    newNode->prev = list->tail;
+    if (list->tail == NULL)
+        list->head = newNode;
+    else
+        list->tail->next = newNode;
+    list->tail = newNode;
+}
+
+// 1. Insert at beginning
+void insertAtBeginning(struct IndexedList* list, int value) {
+    struct Node* newNode = createNode(list, value, 0);
+    newNode->next = list->head;
+    if (list->head != NULL)
+        list->head->prev = newNode;
+    else
+        list->tail = newNode;
+    list->head = newNode;
+    printf("Inserted %d at the beginning.\n", value);
+}
+
+// 2. Insert at end
+void insertAtEnd(struct IndexedList* list, int value) {
+    appendNode(list, value);
+    printf("Inserted %d at the end.\n", value);
+}
+
+// 3. Delete from beginning
+void deleteFromBeginning(struct IndexedList* list) {
+    if (list->head == NULL) {
+        printf("List is empty. Nothing to delete.\n");
+        return;
+    }
+    int value = list->head->data;
+    unlinkNode(list, list->head);
+    printf("Deleted %d from the beginning.\n", value);
+}
+
+// 4. Delete from end
+void deleteFromEnd(struct IndexedList* list) {
+    if (list->tail == NULL) {
+        printf("List is empty. Nothing to delete.\n");
+        return;
+    }
+    int value = list->tail->data;
+    unlinkNode(list, list->tail);
+    printf("Deleted %d from the end.\n", value);
+}
+
+// First node holding 'value' in list order, NULL if none: O(1)
+struct Node* findNode(struct IndexedList* list, int value) {
+    struct Bucket* bucket = findBucket(list, value);
+    return bucket->used ? bucket->first : NULL;
+}
+
+// Delete the first node holding 'value' without printing; returns 1 if found
+static int removeValue(struct IndexedList* list, int value) {
+    struct Node* node = findNode(list, value);
+    if (node == NULL)
+        return 0;
+    unlinkNode(list, node);
+    return 1;
+}
+
+// 5. Delete by value: O(1)
+void deleteByValue(struct IndexedList* list, int value) {
+    if (removeValue(list, value))
+        printf("Deleted node with value %d.\n", value);
+    else
+        printf("Value %d not found in the list.\n", value);
+}
+
+// 6. Search: O(1), reports how many nodes hold the value
+void search(struct IndexedList* list, int value) {
+    struct Bucket* bucket = findBucket(list, value);
+    if (bucket->used)
+        printf("Value %d found (%d occurrence%s).\n", value, bucket->count, bucket->count > 1 ? "s" : "");
+    else
+        printf("Value %d not found in the list.\n", value);
+}
+
+// 7. Display forward
+void displayForward(struct IndexedList* list) {
+    if (list->head == NULL) {
+        printf("List is empty.\n");
+        return;
+    }
+    printf("Forward: ");
+    for (struct Node* temp = list->head; temp != NULL; temp = temp->next)
+        printf("%d <-> ", temp->data);
+    printf("NULL\n");
+}
+
+// 8. Free all nodes: O(1) pool reset plus clearing the index
+void freeList(struct IndexedList* list) {
+    poolReset(&list->pool);
+    memset(list->buckets, 0, (list->mask + 1) * sizeof(struct Bucket));
+    list->usedBuckets = 0;
+    list->head = list->tail = NULL;
+    list->size = 0;
+}
+
+// Release the pool and the table; the list must be initialized again before reuse
+void destroyList(struct IndexedList* list) {
+    destroyPool(&list->pool);
+    free(list->buckets);
+    list->buckets = NULL;
+    list->head = list->tail = NULL;
+    list->size = 0;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The deleteByValue() scan from DoubleLinkedList.c, for comparison
+static int linearRemove(struct IndexedList* list, int value) {
+    for (struct Node* temp = list->head; temp != NULL; temp = temp->next) {
+        if (temp->data == value) {
+            unlinkNode(list, temp);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Build an n-element list with values in [0, n/2) (so most values repeat),
+// then delete 'deletes' random values by key
+void benchmark(int n, int deletes, int linear) {
+    struct IndexedList list;
+    unsigned int seed = 42;
+    int removed = 0;
+
+    initList(&list);
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        appendNode(&list, (int)((seed >> 8) % (unsigned int)(n / 2)));
+    }
+
+    double start = nowNs();
+    for (int i = 0; i < deletes; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int value = (int)((seed >> 8) % (unsigned int)(n / 2));
+        removed += linear ? linearRemove(&list, value) : removeValue(&list, value);
+    }
+    double ns = (nowNs() - start) / deletes;
+
+    printf("  %-7s %9d elements: %10.1f ns per delete-by-value  (%d removed)\n",
+           linear ? "linear" : "indexed", n, ns, removed);
+    destroyList(&list);
+}
+
+// Main Function
+int main() {
+    struct IndexedList list;
+    initList(&list);
+
+    insertAtBeginning(&list, 10);
+    insertAtBeginning(&list, 5);
+    insertAtEnd(&list, 20);
+    insertAtEnd(&list, 10);     // Duplicate value
+    insertAtEnd(&list, 30);
+    displayForward(&list);
+
+    search(&list, 10);
+    deleteByValue(&list, 10);   // Removes the first 10 in list order
+    displayForward(&list);
+    search(&list, 10);
+
+    deleteFromBeginning(&list);
+    deleteFromEnd(&list);
+    displayForward(&list);
+
+    deleteByValue(&list, 100);  // Not in list
+    search(&list, 20);
+    search(&list, 100);
+    freeList(&list);
+    displayForward(&list);
+    destroyList(&list);
+
+    printf("\nDelete by value on lists with duplicate values:\n");
+    benchmark(100000, 2000, 1);
+    benchmark(100000, 2000, 0);
+    benchmark(10000000, 1000000, 0);
+    return 0;
+}
+
+/*
+    output (timings depend on the machine):
+    ----------------------------------
+    Inserted 10 at the beginning.
+    Inserted 5 at the beginning.
+    Inserted 20 at the end.
+    Inserted 10 at the end.
+    Inserted 30 at the end.
+    Forward: 5 <-> 10 <-> 20 <-> 10 <-> 30 <-> NULL
+    Value 10 found (2 occurrences).
+    Deleted node with value 10.
+    Forward: 5 <-> 20 <-> 10 <-> 30 <-> NULL
+    Value 10 found (1 occurrence).
+    Deleted 5 from the beginning.
+    Deleted 30 from the end.
+    Forward: 20 <-> 10 <-> NULL
+    Value 100 not found in the list.
+    Value 20 found (1 occurrence).
+    Value 100 not found in the list.
+    List is empty.
+
+    Delete by value on lists with duplicate values:
+      linear     100000 elements:   126898.5 ns per delete-by-value  (1715 removed)
+      indexed    100000 elements:      141.3 ns per delete-by-value  (1715 removed)
+      indexed  10000000 elements:      314.4 ns per delete-by-value  (838426 removed)
+*/
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>    // for uint32_t
+#include <string.h>    // for memset()
+#include <math.h>      // for pow()
+#include <time.h>      // for clock_gettime()
+#include "NodePool.h"  // for poolAlloc() and poolFree()
+#include "OpenAddressing.h"  // for homeSlot() and probeRemove()
+
+/*
+    Fixed-capacity LRU cache.
+
+    The recency order is a doubly linked list as in DoubleLinkedList.c: the
+    head is the most recently used entry and the tail the least recently used.
+    A hash table (open addressing, linear probing) maps each key to its node,
+    so get, put and evict are all O(1):
+
+        get    find the node, move it to the head
+        put    update in place and move to the head, or link a new node at
+               the head, evicting the tail first when the cache is full
+
+    All 'capacity' nodes are taken from the pool when the cache is created and
+    handed back to its free list, so get/put never call malloc. The table is
+    sized for a load factor of at most 1/2 and never grows.
+*/
+struct Node {
+    int key;
+    int value;
+    struct Node* prev;
+    struct Node* next;
+};
+
+struct Slot {
+    int key;
+    struct Node* node;       // NULL marks an empty slot
+};
+
+struct LRUCache {
+    struct Node* head;       // Most recently used
+    struct Node* tail;       // Least recently used
+    int size;
+    int capacity;
+    struct Slot* slots;
+    uint32_t mask;           // Slot count - 1
+    int shift;               // 32 - log2(slot count)
+    long long hits;
+    long long misses;
+    long long evictions;
+    struct NodePool pool;
+};
+
+static uint32_t hashKey(int key) {
+    // Fibonacci hashing spreads consecutive keys over the table
+    return (uint32_t)key * 2654435769u;
+}
+
+// Create a cache holding up to 'capacity' entries, NULL on failure
+struct LRUCache* createCache(int capacity) {
+    struct LRUCache* cache = (struct LRUCache*)malloc(sizeof(struct LRUCache));
+    uint32_t slotCount = 4;
+
+    if (cache == NULL || capacity <= 0) {
+        free(cache);
+        return NULL;
+    }
+    while (slotCount < 2 * (uint32_t)capacity)
+        slotCount <<= 1;
+    cache->slots = (struct Slot*)calloc(slotCount, sizeof(struct Slot));
+    if (cache->slots == NULL) {
+        free(cache);
+        return NULL;
+    }
+    cache->mask = slotCount - 1;
+    cache->shift = hashShift(slotCount);
+    cache->head = cache->tail = NULL;
+    cache->size = 0;
+    cache->capacity = capacity;
+    cache->hits = cache->misses = cache->evictions = 0;
+
+    // Preallocate every node, then park them on the pool's free list
+    initPool(&cache->pool, sizeof(struct Node));
+    struct Node* chain = NULL;
+    for (int i = 0; i < capacity; i++) {
+        struct Node* node = (struct Node*)poolAlloc(&cache->pool);
+        node->next = chain;
+        chain = node;
+    }
+    while (chain != NULL) {
+        struct Node* next = chain->next;
+        poolFree(&cache->pool, chain);
+        chain = next;
+    }
+    return cache;
+}
+
+// Slot holding 'key', or the empty slot where it would go
+static struct Slot* findSlot(struct LRUCache* cache, int key) {
+    uint32_t i = homeSlot(hashKey(key), cache->shift);
+    while (cache->slots[i].node != NULL && cache->slots[i].key != key)
+        i = (i + 1) & cache->mask;
+    return &cache->slots[i];
+}
+
+// probeRemove() callbacks: 'table' is the cache
+static uint32_t entryHome(const void* table, uint32_t i) {
+    const struct LRUCache* cache = (const struct LRUCache*)table;
+    if (cache->slots[i].node == NULL)
+        return PROBE_EMPTY;
+    return homeSlot(hashKey(cache->slots[i].key), cache->shift);
+}
+
+static void moveEntry(void* table, uint32_t to, uint32_t from) {
+    struct LRUCache* cache = (struct LRUCache*)table;
+    cache->slots[to] = cache->slots[from];
+}
+
+// Empty a slot, shifting later probes back so lookups never hit a hole
+static void removeSlot(struct LRUCache* cache, struct Slot* slot) {
+    uint32_t hole = (uint32_t)(slot - cache->slots);
+    cache->slots[probeRemove(cache, cache->mask, hole, entryHome, moveEntry)].node = NULL;
+}
+
+// Link a node in front of the head
+static void pushFront(struct LRUCache* cache, struct Node* node) {
+    node->prev = NULL;
+    node->next = cache->head;
+    if (cache->head != NULL)
+        cache->head->prev = node;
+    else
+        cache->tail = node;
+    cache->head = node;
+}
+
+// Unlink a node from the recency list
+static void unlinkNode(struct LRUCache* cache, struct Node* node) {
+    if (node->prev == NULL)
+        cache->head = node->next;
+    else
+        node->prev->next = node->next;
+
+    if (node->next == NULL)
+        cache->tail = node->prev;
+    else
+        node->next->prev = node->prev;
+}
+
+// Look up 'key'; on a hit store its value in *value, mark it most recently used and return 1
+int cacheGet(struct LRUCache* cache, int key, int* value) {
+    struct Slot* slot = findSlot(cache, key);
+    if (slot->node == NULL) {
+        cache->misses++;
+        return 0;
+    }
+    struct Node* node = slot->node;
+    if (node != cache->head) {
+        unlinkNode(cache, node);
+        pushFront(cache, node);
+    }
+    *value = node->value;
+    cache->hits++;
+    return 1;
+}
+
+// Insert or update 'key'; evicts the least recently used entry when full
+void cachePut(struct LRUCache* cache, int key, int value) {
+    struct Slot* slot = findSlot(cache, key);
+
+    if (slot->node != NULL) {
+        struct Node* node = slot->node;
+        node->value = value;
+        if (node != cache->head) {
+            unlinkNode(cache, node);
+            pushFront(cache, node);
+        }
+        return;
+    }
+
+    if (cache->size == cache->capacity) {
+        struct Node* victim = cache->tail;
+        unlinkNode(cache, victim);
+        removeSlot(cache, findSlot(cache, victim->key));
+        poolFree(&cache->pool, victim);
+        cache->size--;
+        cache->evictions++;
+        slot = findSlot(cache, key);   // The shift may have moved the free slot
+    }
+
+    struct Node* node = (struct Node*)poolAlloc(&cache->pool);
+    node->key = key;
+    node->value = value;
+    pushFront(cache, node);
+    slot->key = key;
+    slot->node = node;
+    cache->size++;
+}
+
+// Display entries from most to least recently used
+void displayCache(struct LRUCache* cache) {
+    if (cache->head == NULL) {
+        printf("Cache is empty.\n");
+        return;
+    }
+    printf("Cache (MRU -> LRU): ");
+    for (struct Node* node = cache->head; node != NULL; node = node->next)
+        printf("%d:%d <-> ", node->key, node->value);
+    printf("NULL\n");
+}
+
+void printStats(struct LRUCache* cache) {
+    long long lookups = cache->hits + cache->misses;
+    printf("Hits: %lld, misses: %lld, evictions: %lld, hit ratio: %.1f%%\n",
+           cache->hits, cache->misses, cache->evictions,
+           lookups ? 100.0 * cache->hits / lookups : 0.0);
+}
+
+// Drop every entry in O(capacity); the pool keeps its slabs, so refilling still needs no malloc
+void clearCache(struct LRUCache* cache) {
+    poolReset(&cache->pool);
+    memset(cache->slots, 0, (cache->mask + 1) * sizeof(struct Slot));
+    cache->head = cache->tail = NULL;
+    cache->size = 0;
+}
+
+void freeCache(struct LRUCache* cache) {
+    destroyPool(&cache->pool);
+    free(cache->slots);
+    free(cache);
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fill 'trace' with keys in [0, keys) where key k has probability ~ 1/(k+1)^s,
+// by inverting the cumulative distribution with a binary search
+static void zipfTrace(int* trace, int length, int keys, double s, unsigned int seed) {
+    double* cdf = (double*)malloc(keys * sizeof(double));
+    double sum = 0;
+    for (int k = 0; k < keys; k++) {
+        sum += 1.0 / pow(k + 1, s);
+        cdf[k] = sum;
+    }
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        double u = (seed >> 8) / 16777216.0 * sum;
+        int lo = 0, hi = keys - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        // Scatter ranks over the key space so hot keys are not neighbours
+        trace[i] = (int)((uint32_t)lo * 2654435761u % (uint32_t)keys);
+    }
+    free(cdf);
+}
+
+// Replay a trace as get-then-put-on-miss, the usual read-through pattern
+void benchmark(const int* trace, int length, int capacity, double s) {
+    struct LRUCache* cache = createCache(capacity);
+    int value;
+
+    double start = nowNs();
+    for (int i = 0; i < length; i++)
+        if (!cacheGet(cache, trace[i], &value))
+            cachePut(cache, trace[i], trace[i]);
+    double ns = (nowNs() - start) / length;
+
+    printf("  s=%.2f capacity %7d: %5.1f ns/op  ", s, capacity, ns);
+    printStats(cache);
+    freeCache(cache);
+}
+
+// Main Function
+int main() {
+    struct LRUCache* cache = createCache(3);
+    int value;
+
+    cachePut(cache, 1, 10);
+    cachePut(cache, 2, 20);
+    cachePut(cache, 3, 30);
+    displayCache(cache);
+
+    if (cacheGet(cache, 1, &value))   // 1 becomes most recently used
+        printf("Get 1 -> %d\n", value);
+    cachePut(cache, 4, 40);           // Evicts 2, the least recently used
+    displayCache(cache);
+
+    if (!cacheGet(cache, 2, &value))
+        printf("Get 2 -> miss\n");
+    cachePut(cache, 3, 33);           // Update moves 3 to the front
+    displayCache(cache);
+    printStats(cache);
+    clearCache(cache);
+    displayCache(cache);
+    freeCache(cache);
+
+    const int keys = 1000000, length = 10000000;
+    int* trace = (int*)malloc(length * sizeof(int));
+    printf("\nZipfian traces, %d keys, %d lookups:\n", keys, length);
+    for (double s = 0.8; s < 1.3; s += 0.2) {
+        zipfTrace(trace, length, keys, s, 2024);
+        benchmark(trace, length, keys / 100, s);
+        benchmark(trace, length, keys / 10, s);
+    }
+    free(trace);
+    return 0;
+}
+
+/*
+    output (timings depend on the machine):
+    ----------------------------------
+    Cache (MRU -> LRU): 3:30 <-> 2:20 <-> 1:10 <-> NULL
+    Get 1 -> 10
+    Cache (MRU -> LRU): 4:40 <-> 1:10 <-> 3:30 <-> NULL
+    Get 2 -> miss
+    Cache (MRU -> LRU): 3:33 <-> 4:40 <-> 1:10 <-> NULL
+    Hits: 1, misses: 1, evictions: 1, hit ratio: 50.0%
+    Cache is empty.
+
+    Zipfian traces, 1000000 keys, 10000000 lookups:
+      s=0.80 capacity   10000:  59.1 ns/op  Hits: 2349709, misses: 7650291, evictions: 7640291, hit ratio: 23.5%
+      s=0.80 capacity  100000:  82.6 ns/op  Hits: 5132264, misses: 4867736, evictions: 4767736, hit ratio: 51.3%
+      s=1.00 capacity   10000:  40.1 ns/op  Hits: 5860814, misses: 4139186, evictions: 4129186, hit ratio: 58.6%
+      s=1.00 capacity  100000:  66.6 ns/op  Hits: 7880906, misses: 2119094, evictions: 2019094, hit ratio: 78.8%
+      s=1.20 capacity   10000:  18.5 ns/op  Hits: 8754890, misses: 1245110, evictions: 1235110, hit ratio: 87.5%
+      s=1.20 capacity  100000:  39.9 ns/op  Hits: 9498276, misses: 501724, evictions: 401724, hit ratio: 95.0%
+*/
@@ -0,0 +1,148 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+    Slab-based node pool shared by the linked list programs.
+
+    Nodes are carved out of large slabs with a bump pointer, and freed nodes
+    go on a free list that the next allocation reuses first. That replaces one
+    malloc()/free() call per 16-24 byte node with a couple of pointer moves,
+    and keeps nodes of one list packed together in memory.
+
+    Slabs are never returned one node at a time. poolReset() forgets every
+    node at once in O(1) and keeps the slabs for reuse, which is how a whole
+    list is torn down; destroyPool() finally gives the slabs back to malloc.
+
+    initAlignedPool() takes a power-of-two alignment for nodes such as the
+    cache-line nodes of UnrolledLinkedList.c: slabs then come from
+    aligned_alloc(), the first node starts at the next aligned byte after
+    the slab header and the node size is rounded up to the alignment.
+
+    Usage:
+        static struct NodePool pool = NODE_POOL_INIT(struct Node);
+        struct Node* n = (struct Node*)poolAlloc(&pool);
+        poolFree(&pool, n);
+        poolReset(&pool);      // drop all nodes
+        destroyPool(&pool);    // release memory
+
+        initAlignedPool(&lines, sizeof(struct Line), 64);   // 64-byte aligned nodes
+*/
+
+#define POOL_SLAB_BYTES (64 * 1024)  // Size of one slab including its header
+
+struct PoolSlab {
+    struct PoolSlab* next;   // Next slab in allocation order
+    char* end;               // One past the last usable byte
+};
+
+struct PoolFreeNode {
+    struct PoolFreeNode* next;
+};
+
+struct NodePool {
+    size_t nodeSize;               // Bytes per node, at least one pointer
+    size_t align;                  // Node alignment in slabs, 0 for malloc()'s
+    struct PoolSlab* slabs;        // First slab (kept across resets)
+    struct PoolSlab* current;      // Slab the bump pointer is in
+    char* bump;                    // Next never-used node in 'current'
+    struct PoolFreeNode* freeList; // Nodes returned by poolFree()
+};
+
+// Round a node size up to whole pointers so every node can hold a free-list link
+#define POOL_NODE_SIZE(size) \
+    (((size) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*))
+
+// Static initializer for a pool of nodes of the given type
+#define NODE_POOL_INIT(type) { POOL_NODE_SIZE(sizeof(type)), 0, NULL, NULL, NULL, NULL }
+
+// Round 'size' up to a multiple of 'align' (a power of two)
+#define POOL_ALIGN_UP(size, align) (((size) + (align) - 1) & ~((size_t)(align) - 1))
+
+// Runtime initializer, same as NODE_POOL_INIT
+static inline void initPool(struct NodePool* pool, size_t nodeSize) {
+    pool->nodeSize = POOL_NODE_SIZE(nodeSize);
+    pool->align = 0;
+    pool->slabs = NULL;
+    pool->current = NULL;
+    pool->bump = NULL;
+    pool->freeList = NULL;
+}
+
+// Pool whose nodes start on 'align'-byte boundaries (a power of two, at most
+// POOL_SLAB_BYTES / 2)
+static inline void initAlignedPool(struct NodePool* pool, size_t nodeSize, size_t align) {
+    initPool(pool, POOL_ALIGN_UP(nodeSize, align));
+    pool->align = align;
+}
+
+// Move the bump pointer into the next slab, allocating one if needed
+static inline int poolNextSlab(struct NodePool* pool) {
+    struct PoolSlab* slab = pool->current ? pool->current->next : pool->slabs;
+
+    if (slab == NULL) {
+        slab = (struct PoolSlab*)(pool->align ? aligned_alloc(pool->align, POOL_SLAB_BYTES)
+                                              : malloc(POOL_SLAB_BYTES));
+        if (slab == NULL)
+            return 0;
+        slab->next = NULL;
+        slab->end = (char*)slab + POOL_SLAB_BYTES;
+        if (pool->current != NULL)
+            pool->current->next = slab;
+        else
+            pool->slabs = slab;
+    }
+    pool->current = slab;
+    pool->bump = pool->align ? (char*)slab + POOL_ALIGN_UP(sizeof(struct PoolSlab), pool->align)
+                             : (char*)(slab + 1);
+    return 1;
+}
+
+// Allocate one node: free list first, then the bump pointer
+static inline void* poolAlloc(struct NodePool* pool) {
+    if (pool->freeList != NULL) {
+        struct PoolFreeNode* node = pool->freeList;
+        pool->freeList = node->next;
+        return node;
+    }
+    if (pool->bump == NULL || pool->bump + pool->nodeSize > pool->current->end) {
+        if (!poolNextSlab(pool)) {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+    }
+    void* node = pool->bump;
+    pool->bump += pool->nodeSize;
+    return node;
+}
+
+// Return one node to the pool
+static inline void poolFree(struct NodePool* pool, void* node) {
+    struct PoolFreeNode* freed = (struct PoolFreeNode*)node;
+    freed->next = pool->freeList;
+    pool->freeList = freed;
+}
+
+// Drop every node in O(1); the slabs stay allocated for reuse
+static inline void poolReset(struct NodePool* pool) {
+    pool->current = NULL;
+    pool->bump = NULL;
+    pool->freeList = NULL;
+}
+
+// Release all slabs back to malloc
+static inline void destroyPool(struct NodePool* pool) {
+    struct PoolSlab* slab = pool->slabs;
+    while (slab != NULL) {
+        struct PoolSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    size_t align = pool->align;
+    initPool(pool, pool->nodeSize);
+    pool->align = align;
+}
+
+#endif // NODE_POOL_H
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>      // for clock_gettime()
+#include "NodePool.h"  // for poolAlloc(), poolFree() and poolReset()
+
+#define NODES 1000000  // List length for each round
+#define ROUNDS 10      // Build/churn/teardown rounds per allocator
+
+// Same node layout as SinglyLinkedList.c
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+static struct NodePool pool = NODE_POOL_INIT(struct Node);
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// One allocator under test
+struct Allocator {
+    const char* name;
+    struct Node* (*alloc)(void);
+    void (*release)(struct Node*);
+    void (*freeAll)(struct Node**);
+};
+
+static struct Node* mallocNode(void) { return (struct Node*)malloc(sizeof(struct Node)); }
+static void mallocRelease(struct Node* n) { free(n); }
+static void mallocFreeAll(struct Node** head) {
+    while (*head != NULL) {
+        struct Node* temp = *head;
+        *head = temp->next;
+        free(temp);
+    }
+}
+
+static struct Node* poolNode(void) { return (struct Node*)poolAlloc(&pool); }
+static void poolRelease(struct Node* n) { poolFree(&pool, n); }
+static void poolFreeAll(struct Node** head) {
+    poolReset(&pool);
+    *head = NULL;
+}
+
+// Build a list, churn it with delete-head/insert pairs, then tear it down
+void benchmark(const struct Allocator* a) {
+    double build = 0, churn = 0, teardown = 0;
+    long long checksum = 0;
+
+    for (int r = 0; r < ROUNDS; r++) {
+        struct Node* head = NULL;
+        double start = nowNs();
+        for (int i = 0; i < NODES; i++) {
+            struct Node* n = a->alloc();
+            n->data = i;
+            n->next = head;
+            head = n;
+        }
+        double t1 = nowNs();
+
+        // Delete a node and insert a new one, NODES times
+        for (int i = 0; i < NODES; i++) {
+            struct Node* old = head;
+            head = head->next;
+            checksum += old->data;
+            a->release(old);
+            struct Node* n = a->alloc();
+            n->data = i;
+            n->next = head;
+            head = n;
+        }
+        double t2 = nowNs();
+
+        a->freeAll(&head);
+        double t3 = nowNs();
+
+        build += t1 - start;
+        churn += t2 - t1;
+        teardown += t3 - t2;
+    }
+
+    double ops = (double)NODES * ROUNDS;
+    printf("%-8s insert %6.2f ns/op  delete+insert %6.2f ns/op  teardown %9.3f ms/list  (checksum %lld)\n",
+           a->name, build / ops, churn / ops, teardown / ROUNDS / 1e6, checksum);
+}
+
+// Driver Code
+int main() {
+    struct Allocator mallocAllocator = {"malloc", mallocNode, mallocRelease, mallocFreeAll};
+    struct Allocator poolAllocator = {"pool", poolNode, poolRelease, poolFreeAll};
+
+    printf("%d rounds of a %d-node singly linked list:\n", ROUNDS, NODES);
+    benchmark(&mallocAllocator);
+    benchmark(&poolAllocator);
+
+    destroyPool(&pool);
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine and the C library allocator):
+    -----------------------------------
+    10 rounds of a 1000000-node singly linked list:
+    malloc   insert  13.76 ns/op  delete+insert  14.66 ns/op  teardown    10.654 ms/list  (checksum 4999995000000)
+    pool     insert   5.68 ns/op  delete+insert   3.60 ns/op  teardown     0.000 ms/list  (checksum 4999995000000)
+*/
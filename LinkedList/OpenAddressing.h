@@ -0,0 +1,72 @@
+#ifndef OPEN_ADDRESSING_H
+#define OPEN_ADDRESSING_H
+
+#include <stdint.h>
+
+/*
+    Helpers shared by the open-addressing hash tables (linear probing,
+    power-of-two size) in IndexedLinkedList.c, LRUCache.c and the expression
+    caches in StacksAndQueues.
+
+    Home slot: a multiplicative hash mixes its input into the high bits of
+    the product, so a table of 2^k slots takes the top k bits of the hash,
+    hash >> (32 - k). Each table keeps that shift next to its mask and
+    decrements it whenever it doubles.
+
+    Removal is backward-shift deletion: after a slot is emptied, every entry
+    further along the same probe run whose home slot does not lie between the
+    hole and its current slot moves back into the hole. Lookups therefore
+    never stop early at a hole, and no tombstones are needed. The table
+    describes itself through two callbacks:
+
+        uint32_t slotHome(const void* table, uint32_t i)
+            home slot of the entry in slot i, PROBE_EMPTY if slot i is empty
+        void moveSlot(void* table, uint32_t to, uint32_t from)
+            copy the entry in slot 'from' into slot 'to'
+
+    Callers pass named static functions, so at -O2 both calls are inlined
+    into the loop. probeRemove() returns the slot left empty at the end of
+    the run; the caller marks it empty.
+
+    Usage:
+        uint32_t i = homeSlot(hash, table->shift);
+        while (slot i is used and holds another key)
+            i = (i + 1) & table->mask;
+        ...
+        uint32_t last = probeRemove(table, table->mask, i, entryHome, moveEntry);
+        mark slot 'last' empty;
+*/
+
+#define PROBE_EMPTY UINT32_MAX   // slotHome() result for an empty slot
+
+// Shift that selects the top bits of a 32-bit hash for 'slotCount' slots (a power of two)
+static inline int hashShift(uint32_t slotCount) {
+    return 32 - __builtin_ctz(slotCount);
+}
+
+// Home slot of 'hash' in a table whose shift is 'shift'
+static inline uint32_t homeSlot(uint32_t hash, int shift) {
+    return (uint32_t)((uint64_t)hash >> shift);   // 64-bit so a 1-slot table (shift 32) is defined
+}
+
+// Backward-shift deletion starting at 'hole'; returns the slot to mark empty
+static inline uint32_t probeRemove(void* table, uint32_t mask, uint32_t hole,
+                                   uint32_t (*slotHome)(const void* table, uint32_t i),
+                                   void (*moveSlot)(void* table, uint32_t to, uint32_t from)) {
+    uint32_t i = hole;
+
+    for (;;) {
+        i = (i + 1) & mask;
+        uint32_t home = slotHome(table, i);
+        if (home == PROBE_EMPTY)
+            break;
+        // Move the entry into the hole if its home slot is not between hole and i
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            moveSlot(table, hole, i);
+            hole = i;
+        }
+    }
+    return hole;
+}
+
+#endif
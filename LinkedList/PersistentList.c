@@ -0,0 +1,584 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>     // for offsetof()
+#include <stdint.h>     // for uint32_t, uint64_t
+#include <string.h>     // for memcmp(), memcpy()
+#include <time.h>       // for clock_gettime()
+#include <fcntl.h>      // for open()
+#include <unistd.h>     // for ftruncate(), close(), unlink()
+#include <sys/mman.h>   // for mmap(), msync()
+#include <sys/stat.h>   // for fstat()
+#include "NodePool.h"   // for the replay baseline in the benchmark
+
+/*
+    Persistent singly, doubly and circular linked lists in a memory-mapped file.
+
+    The file is used in place: opening it maps it and checks one header, with
+    no parsing and no per-node work, so startup is O(1) instead of replaying
+    every insertAtEnd() call. Links are 32-bit node offsets (index into the
+    node area, as in the compact lists) rather than pointers, so they stay
+    valid wherever the file is mapped.
+
+    File layout (version 1):
+
+        0     header slot A   (512 bytes, one disk sector)
+        512   header slot B
+        4096  node area: capacity x struct PNode
+
+    Crash safety: the header slots are double-buffered. A commit writes the
+    new header (sequence + 1, CRC32 over its fields) into the slot the current
+    header is NOT in, so a torn header write leaves the previous one intact;
+    opening picks the valid slot with the higher sequence. New nodes are
+    written past the committed ones before the header that makes them
+    reachable, and slots are never reused in place, so a crash before the
+    commit only leaves an unreachable node. The links leading out of the list, the tail's
+    next and the head's prev, are not part of the committed state: readers
+    walk 'size' nodes from the head and take both ends from the header. Those
+    are the only links a mutation writes ahead of its commit, so whichever
+    header survives, every link it can reach is one it committed.
+
+    Checksums: besides the header CRC, the header carries a CRC32 of every
+    node value ever written, in slot order. Nodes are append-only, so it is
+    extended in O(1) per insert; verifyList() recomputes it in O(n) when a
+    full integrity check is wanted.
+
+    Compaction: deleted nodes stay in their slots as dead space, counted by
+    deadSlots(). compactList() reclaims them in two commits, each writing
+    only slots the committed header cannot reach. It first appends a copy of
+    the live nodes, in list order, past 'used' and commits a header pointing
+    at the copy; then everything before the copy is dead, so it copies the
+    nodes back to slots 0 .. size-1, commits again and shrinks the file. A
+    crash at any point leaves one of the three headers, each complete.
+
+    With 'durable' set, each commit msync()s the new nodes before writing the
+    header and the header afterwards, so the order also holds across power
+    loss. Without it, commits survive a process crash (the page cache keeps
+    MAP_SHARED writes) at memory speed.
+*/
+
+#define FILE_VERSION 1
+#define HEADER_SLOT_BYTES 512
+#define NODE_AREA_OFFSET 4096
+#define INITIAL_NODES 1024
+#define NIL UINT32_MAX
+
+enum ListKind { LIST_SINGLY = 1, LIST_DOUBLY = 2, LIST_CIRCULAR = 3 };
+
+static const char fileMagic[8] = "DSALIST";
+
+// On-disk header, one copy per slot
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;           // enum ListKind
+    uint64_t sequence;       // Commit counter; the valid slot with the higher one wins
+    uint32_t head;           // Node offsets, NIL when the list is empty
+    uint32_t tail;
+    uint32_t size;           // Nodes reachable from head
+    uint32_t used;           // Node slots ever written
+    uint32_t capacity;       // Node slots in the file
+    uint32_t dataCrc;        // CRC32 of data[0 .. used)
+    uint32_t headerCrc;      // CRC32 of every field above
+};
+
+// On-disk node
+struct PNode {
+    int32_t data;
+    uint32_t next;
+    uint32_t prev;           // Used by LIST_DOUBLY only
+};
+
+// Open list: the mapping plus a working copy of the header
+struct PersistentList {
+    int fd;
+    char* map;
+    size_t mapBytes;
+    struct PNode* nodes;
+    struct FileHeader header;    // State to publish on the next commit
+    uint32_t dirtyFrom;          // First node written since the last commit
+    int durable;                 // msync() on every commit
+};
+
+// CRC-32 (IEEE 802.3, as in zlib); pass 0 to start, the previous result to continue
+static uint32_t crc32(uint32_t crc, const void* buf, size_t len) {
+    static uint32_t table[256];
+    const unsigned char* p = (const unsigned char*)buf;
+
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    while (len--)
+        crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t headerCrc(const struct FileHeader* h) {
+    return crc32(0, h, offsetof(struct FileHeader, headerCrc));
+}
+
+static struct FileHeader* headerSlot(struct PersistentList* list, int slot) {
+    return (struct FileHeader*)(list->map + slot * HEADER_SLOT_BYTES);
+}
+
+static int headerValid(const struct FileHeader* h) {
+    return memcmp(h->magic, fileMagic, sizeof(fileMagic)) == 0 &&
+           h->version == FILE_VERSION && h->headerCrc == headerCrc(h);
+}
+
+// Map 'bytes' of the file, replacing any previous mapping
+static int mapFile(struct PersistentList* list, size_t bytes) {
+    if (list->map != NULL)
+        munmap(list->map, list->mapBytes);
+    list->map = (char*)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, list->fd, 0);
+    if (list->map == MAP_FAILED) {
+        list->map = NULL;
+        return 0;
+    }
+    list->mapBytes = bytes;
+    list->nodes = (struct PNode*)(list->map + NODE_AREA_OFFSET);
+    return 1;
+}
+
+static size_t fileBytes(uint32_t capacity) {
+    return NODE_AREA_OFFSET + (size_t)capacity * sizeof(struct PNode);
+}
+
+// Publish the working header: new nodes first, then the other header slot
+static void commit(struct PersistentList* list) {
+    struct FileHeader* h = &list->header;
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (list->durable && list->dirtyFrom < h->used) {
+        size_t from = (NODE_AREA_OFFSET + (size_t)list->dirtyFrom * sizeof(struct PNode)) / page * page;
+        msync(list->map + from, fileBytes(h->used) - from, MS_SYNC);
+    }
+    h->sequence++;
+    h->headerCrc = headerCrc(h);
+    memcpy(headerSlot(list, (int)(h->sequence & 1)), h, sizeof(*h));
+    if (list->durable)
+        msync(list->map, page, MS_SYNC);
+    list->dirtyFrom = h->used;
+}
+
+void closeList(struct PersistentList* list) {
+    if (list->map != NULL)
+        munmap(list->map, list->mapBytes);
+    close(list->fd);
+    free(list);
+}
+
+// Open 'path', creating an empty list of 'kind' if the file does not exist.
+// Returns NULL (with a message) if the file is unreadable or of another kind.
+struct PersistentList* openList(const char* path, enum ListKind kind, int durable) {
+    struct PersistentList* list = (struct PersistentList*)calloc(1, sizeof(struct PersistentList));
+    struct stat st;
+
+    if (list == NULL)
+        return NULL;
+    list->durable = durable;
+    list->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (list->fd < 0 || fstat(list->fd, &st) != 0) {
+        perror(path);
+        free(list);
+        return NULL;
+    }
+
+    if (st.st_size == 0) {
+        // New file: an empty list committed to slot A
+        if (ftruncate(list->fd, (off_t)fileBytes(INITIAL_NODES)) != 0 ||
+            !mapFile(list, fileBytes(INITIAL_NODES))) {
+            perror(path);
+            close(list->fd);
+            free(list);
+            return NULL;
+        }
+        memcpy(list->header.magic, fileMagic, sizeof(fileMagic));
+        list->header.version = FILE_VERSION;
+        list->header.kind = kind;
+        list->header.sequence = (uint64_t)-1;    // First commit makes it 0, slot A
+        list->header.head = list->header.tail = NIL;
+        list->header.capacity = INITIAL_NODES;
+        commit(list);
+        return list;
+    }
+
+    if ((size_t)st.st_size < NODE_AREA_OFFSET || !mapFile(list, (size_t)st.st_size)) {
+        printf("%s: not a list file.\n", path);
+        close(list->fd);
+        free(list);
+        return NULL;
+    }
+    struct FileHeader* a = headerSlot(list, 0);
+    struct FileHeader* b = headerSlot(list, 1);
+    int validA = headerValid(a), validB = headerValid(b);
+    if (!validA && !validB) {
+        printf("%s: no valid header.\n", path);
+        closeList(list);
+        return NULL;
+    }
+    list->header = validA && (!validB || a->sequence > b->sequence) ? *a : *b;
+    if (list->header.kind != (uint32_t)kind || fileBytes(list->header.capacity) > (size_t)st.st_size) {
+        printf("%s: header does not match the file.\n", path);
+        closeList(list);
+        return NULL;
+    }
+    list->dirtyFrom = list->header.used;
+    return list;
+}
+
+// Make room for 'count' more node slots past the used ones
+static void reserveNodes(struct PersistentList* list, uint32_t count) {
+    struct FileHeader* h = &list->header;
+    uint32_t capacity = h->capacity;
+
+    while (capacity - h->used < count)
+        capacity *= 2;
+    if (capacity != h->capacity) {
+        // Grow the file; the capacity becomes official with the next commit
+        if (ftruncate(list->fd, (off_t)fileBytes(capacity)) != 0 || !mapFile(list, fileBytes(capacity))) {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+        h->capacity = capacity;
+    }
+}
+
+// Write a new node past the committed ones; returns its offset
+static uint32_t createNode(struct PersistentList* list, int value) {
+    struct FileHeader* h = &list->header;
+    reserveNodes(list, 1);
+    uint32_t i = h->used++;
+    list->nodes[i].data = value;
+    list->nodes[i].next = NIL;
+    list->nodes[i].prev = NIL;
+    h->dataCrc = crc32(h->dataCrc, &list->nodes[i].data, sizeof(int32_t));
+    return i;
+}
+
+// Link without committing, shared by insertAtEnd() and the crash demo
+static void appendNode(struct PersistentList* list, int value) {
+    struct FileHeader* h = &list->header;
+    uint32_t newNode = createNode(list, value);
+
+    if (h->size == 0) {
+        h->head = newNode;
+        if (h->kind == LIST_CIRCULAR)
+            list->nodes[newNode].next = newNode;
+    } else {
+        list->nodes[h->tail].next = newNode;   // Outside the committed list until the commit
+        list->nodes[newNode].prev = h->tail;
+        if (h->kind == LIST_CIRCULAR)
+            list->nodes[newNode].next = h->head;
+    }
+    h->tail = newNode;
+    h->size++;
+}
+
+// 1. Insert at end: O(1) plus one commit
+void insertAtEnd(struct PersistentList* list, int value) {
+    appendNode(list, value);
+    commit(list);
+}
+
+// 2. Insert at beginning: O(1) plus one commit
+void insertAtBeginning(struct PersistentList* list, int value) {
+    struct FileHeader* h = &list->header;
+    uint32_t newNode = createNode(list, value);
+
+    if (h->size == 0) {
+        h->tail = newNode;
+        if (h->kind == LIST_CIRCULAR)
+            list->nodes[newNode].next = newNode;
+    } else {
+        list->nodes[newNode].next = h->head;
+        if (h->kind == LIST_DOUBLY)
+            list->nodes[h->head].prev = newNode;   // Outside the committed list until the commit
+        if (h->kind == LIST_CIRCULAR)
+            list->nodes[h->tail].next = newNode;
+    }
+    h->head = newNode;
+    h->size++;
+    commit(list);
+}
+
+// 3. Delete from beginning: only the header changes. The node's slot stays
+//    dead until compactList(), which is what keeps appends crash-safe.
+int deleteFromBeginning(struct PersistentList* list, int* value) {
+    struct FileHeader* h = &list->header;
+    if (h->size == 0)
+        return 0;
+
+    uint32_t old = h->head;
+    *value = list->nodes[old].data;
+    if (h->size == 1) {
+        h->head = h->tail = NIL;
+    } else {
+        h->head = list->nodes[old].next;
+    }
+    h->size--;
+    commit(list);
+    return 1;
+}
+
+// 4. Display the list
+void displayList(struct PersistentList* list) {
+    struct FileHeader* h = &list->header;
+    if (h->size == 0) {
+        printf("List is empty.\n");
+        return;
+    }
+    const char* arrow = h->kind == LIST_DOUBLY ? " <-> " : " -> ";
+    printf("List: ");
+    uint32_t i = h->head;
+    for (uint32_t n = 0; n < h->size; n++, i = list->nodes[i].next)
+        printf("%d%s", list->nodes[i].data, arrow);
+    printf(h->kind == LIST_CIRCULAR ? "(head)\n" : "NULL\n");
+}
+
+// 5. Full integrity check, O(n): data CRC, link bounds, back links and tail
+int verifyList(struct PersistentList* list) {
+    struct FileHeader* h = &list->header;
+    uint32_t crc = 0, i = h->head, prev = NIL;
+
+    for (uint32_t n = 0; n < h->used; n++)
+        crc = crc32(crc, &list->nodes[n].data, sizeof(int32_t));
+    if (crc != h->dataCrc)
+        return 0;
+    for (uint32_t n = 0; n < h->size; n++) {
+        if (i >= h->used || (h->kind == LIST_DOUBLY && n > 0 && list->nodes[i].prev != prev))
+            return 0;
+        prev = i;
+        i = list->nodes[i].next;
+    }
+    return prev == h->tail;
+}
+
+// Node slots written but no longer reachable from the head
+uint32_t deadSlots(const struct PersistentList* list) {
+    return list->header.used - list->header.size;
+}
+
+// Write the live nodes in list order to slots base .. base + size - 1 and
+// point the working header at them; the slots must not overlap the live ones
+static void copyLiveNodes(struct PersistentList* list, uint32_t base) {
+    struct FileHeader* h = &list->header;
+    uint32_t i = h->head;
+
+    for (uint32_t k = 0; k < h->size; k++) {
+        struct PNode* node = &list->nodes[base + k];
+        node->data = list->nodes[i].data;
+        i = list->nodes[i].next;
+        node->prev = k > 0 ? base + k - 1 : NIL;
+        node->next = k + 1 < h->size ? base + k + 1 : h->kind == LIST_CIRCULAR ? base : NIL;
+    }
+    h->head = h->size ? base : NIL;
+    h->tail = h->size ? base + h->size - 1 : NIL;
+}
+
+// 6. Reclaim dead slots, O(size): two commits, then the file shrinks to fit
+void compactList(struct PersistentList* list) {
+    struct FileHeader* h = &list->header;
+    uint32_t base = h->used;
+
+    if (deadSlots(list) == 0)
+        return;
+
+    // Step 1: a copy past the used slots, unreachable until the commit
+    reserveNodes(list, h->size);
+    copyLiveNodes(list, base);
+    for (uint32_t k = 0; k < h->size; k++)
+        h->dataCrc = crc32(h->dataCrc, &list->nodes[base + k].data, sizeof(int32_t));
+    h->used = base + h->size;
+    commit(list);
+
+    // Step 2: every slot before 'base' is dead now, so the copy moves to the front
+    copyLiveNodes(list, 0);
+    h->dataCrc = 0;
+    for (uint32_t k = 0; k < h->size; k++)
+        h->dataCrc = crc32(h->dataCrc, &list->nodes[k].data, sizeof(int32_t));
+    h->used = h->size;
+    while (h->capacity > INITIAL_NODES && h->capacity / 2 >= h->used)
+        h->capacity /= 2;
+    list->dirtyFrom = 0;
+    commit(list);
+
+    // Until this runs the file is just longer than the capacity, which opens fine
+    if (fileBytes(h->capacity) < list->mapBytes &&
+        (ftruncate(list->fd, (off_t)fileBytes(h->capacity)) != 0 || !mapFile(list, fileBytes(h->capacity)))) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The replay a restart does today: n insertAtEnd() calls into a pooled list
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+static double replayMs(const struct PersistentList* source) {
+    struct NodePool pool;
+    struct Node* head = NULL;
+    struct Node* tail = NULL;
+    uint32_t i = source->header.head;
+
+    initPool(&pool, sizeof(struct Node));
+    double start = nowNs();
+    for (uint32_t n = 0; n < source->header.size; n++, i = source->nodes[i].next) {
+        struct Node* node = (struct Node*)poolAlloc(&pool);
+        node->data = source->nodes[i].data;
+        node->next = NULL;
+        if (tail == NULL) head = node;
+        else tail->next = node;
+        tail = node;
+    }
+    double ms = (nowNs() - start) / 1e6;
+    destroyPool(&pool);
+    (void)head;
+    return ms;
+}
+
+void benchmark(const char* path, int n) {
+    struct PersistentList* list;
+    int value;
+
+    unlink(path);
+    list = openList(path, LIST_SINGLY, 0);
+    double start = nowNs();
+    for (int i = 0; i < n; i++)
+        insertAtEnd(list, i);
+    printf("  %d appends, commit per append: %.1f ns each\n", n, (nowNs() - start) / n);
+    closeList(list);
+
+    start = nowNs();
+    list = openList(path, LIST_SINGLY, 0);
+    double openUs = (nowNs() - start) / 1e3;
+    deleteFromBeginning(list, &value);     // Touch the data once
+    printf("  cold start by mmap:    %10.1f us (%u nodes usable in place)\n", openUs, list->header.size);
+    printf("  cold start by replay:  %10.1f us\n", replayMs(list) * 1e3);
+    start = nowNs();
+    int ok = verifyList(list);
+    printf("  optional full verify:  %10.1f us (%s)\n", (nowNs() - start) / 1e3, ok ? "ok" : "CORRUPT");
+    for (int i = 1; i < n / 2; i++)
+        deleteFromBeginning(list, &value);
+    size_t before = list->mapBytes;
+    uint32_t dead = deadSlots(list);
+    start = nowNs();
+    compactList(list);
+    printf("  compact after deleting half: %.1f ms (%u dead slots, file %zu -> %zu MB)\n",
+           (nowNs() - start) / 1e6, dead, before >> 20, list->mapBytes >> 20);
+    closeList(list);
+
+    list = openList(path, LIST_SINGLY, 1);
+    start = nowNs();
+    for (int i = 0; i < 100; i++)
+        insertAtEnd(list, i);
+    printf("  durable appends (msync per commit): %.1f us each\n", (nowNs() - start) / 100 / 1e3);
+    closeList(list);
+    unlink(path);
+}
+
+// Main Function
+int main() {
+    const char* path = "persistent_list.dat";
+    struct PersistentList* list;
+    int value;
+
+    unlink(path);
+    list = openList(path, LIST_DOUBLY, 0);
+    insertAtEnd(list, 10);
+    insertAtEnd(list, 20);
+    insertAtBeginning(list, 5);
+    insertAtEnd(list, 30);
+    displayList(list);
+    closeList(list);
+
+    printf("Reopened: ");
+    list = openList(path, LIST_DOUBLY, 0);
+    displayList(list);
+
+    // Simulated crash: the node is written and linked, but never committed
+    appendNode(list, 99);
+    closeList(list);
+    printf("After a crash during insertAtEnd(99): ");
+    list = openList(path, LIST_DOUBLY, 0);
+    displayList(list);
+    printf("Verify: %s\n", verifyList(list) ? "ok" : "CORRUPT");
+
+    // Torn header write: trash the newest slot, the older one takes over
+    deleteFromBeginning(list, &value);
+    printf("Deleted %d from the beginning.\n", value);
+    memset(headerSlot(list, (int)(list->header.sequence & 1)), 0xAB, sizeof(struct FileHeader));
+    closeList(list);
+    printf("After a torn header write: ");
+    list = openList(path, LIST_DOUBLY, 0);
+    displayList(list);
+    printf("Verify: %s\n", verifyList(list) ? "ok" : "CORRUPT");
+    closeList(list);
+    unlink(path);
+
+    printf("Circular: ");
+    list = openList(path, LIST_CIRCULAR, 0);
+    for (int i = 1; i <= 4; i++)
+        insertAtEnd(list, i * 10);
+    displayList(list);
+    closeList(list);
+    unlink(path);
+
+    // Deleted nodes stay as dead slots until compactList()
+    list = openList(path, LIST_DOUBLY, 1);
+    for (int i = 1; i <= 6; i++)
+        insertAtEnd(list, i * 10);
+    for (int i = 0; i < 4; i++)
+        deleteFromBeginning(list, &value);
+    printf("After 6 appends and 4 deletes: %u dead slots\n", deadSlots(list));
+    compactList(list);
+    closeList(list);
+    printf("Compacted and reopened: ");
+    list = openList(path, LIST_DOUBLY, 0);
+    displayList(list);
+    printf("Dead slots: %u, verify: %s\n", deadSlots(list), verifyList(list) ? "ok" : "CORRUPT");
+    closeList(list);
+    unlink(path);
+
+    printf("\nCold start with 10000000 nodes:\n");
+    benchmark(path, 10000000);
+    return 0;
+}
+
+/*
+    output (timings depend on the machine):
+    ----------------------------------
+    List: 5 <-> 10 <-> 20 <-> 30 <-> NULL
+    Reopened: List: 5 <-> 10 <-> 20 <-> 30 <-> NULL
+    After a crash during insertAtEnd(99): List: 5 <-> 10 <-> 20 <-> 30 <-> NULL
+    Verify: ok
+    Deleted 5 from the beginning.
+    After a torn header write: List: 5 <-> 10 <-> 20 <-> 30 <-> NULL
+    Verify: ok
+    Circular: List: 10 -> 20 -> 30 -> 40 -> (head)
+    After 6 appends and 4 deletes: 4 dead slots
+    Compacted and reopened: List: 50 <-> 60 <-> NULL
+    Dead slots: 0, verify: ok
+
+    Cold start with 10000000 nodes:
+      10000000 appends, commit per append: 178.7 ns each
+      cold start by mmap:          59.1 us (9999999 nodes usable in place)
+      cold start by replay:    168611.4 us
+      optional full verify:    211227.9 us (ok)
+      compact after deleting half: 261.4 ms (5000000 dead slots, file 192 -> 96 MB)
+      durable appends (msync per commit): 333.7 us each
+*/
@@ -0,0 +1,202 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+/*
+    Value search kernels over contiguous int storage (unrolled list nodes,
+    index-linked node arrays, plain arrays).
+
+        findFirst(data, n, value)             index of the first match, -1 if none
+        countMatches(data, n, value)          number of matches
+        findAll(data, n, value, positions)    writes every match index, returns the count
+
+    Each kernel has a portable scalar version and, on x86, SSE4.1 and AVX2
+    versions compiled with per-function target attributes, so the program
+    itself needs no -mavx2 flag. The first call checks the CPU with
+    __builtin_cpu_supports() and binds the best version through function
+    pointers; later calls go straight to it.
+*/
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Scalar versions, also used for the tail that does not fill a vector
+static int findFirstScalar(const int* data, int n, int value) {
+    for (int i = 0; i < n; i++)
+        if (data[i] == value)
+            return i;
+    return -1;
+}
+
+static int countMatchesScalar(const int* data, int n, int value) {
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += data[i] == value;
+    return count;
+}
+
+static int findAllScalar(const int* data, int n, int value, int* positions) {
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        if (data[i] == value)
+            positions[count++] = i;
+    return count;
+}
+
+#ifdef SIMD_SEARCH_X86
+
+__attribute__((target("sse4.1")))
+static int findFirstSse4(const int* data, int n, int value) {
+    __m128i key = _mm_set1_epi32(value);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i)), key);
+        if (!_mm_testz_si128(eq, eq))
+            return i + __builtin_ctz(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+    }
+    int rest = findFirstScalar(data + i, n - i, value);
+    return rest < 0 ? -1 : i + rest;
+}
+
+__attribute__((target("sse4.1")))
+static int countMatchesSse4(const int* data, int n, int value) {
+    __m128i key = _mm_set1_epi32(value);
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    // Matching lanes are -1, so subtracting the mask counts them per lane
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i)), key));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc) + countMatchesScalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse4.1")))
+static int findAllSse4(const int* data, int n, int value, int* positions) {
+    __m128i key = _mm_set1_epi32(value);
+    int count = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i)), key);
+        unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (mask) {
+            positions[count++] = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    for (; i < n; i++)
+        if (data[i] == value)
+            positions[count++] = i;
+    return count;
+}
+
+__attribute__((target("avx2")))
+static int findFirstAvx2(const int* data, int n, int value) {
+    __m256i key = _mm256_set1_epi32(value);
+    int i = 0;
+    // Two vectors per iteration so the loop is not bound by the branch
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), key);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i + 8)), key);
+        __m256i any = _mm256_or_si256(a, b);
+        if (!_mm256_testz_si256(any, any)) {
+            unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(a)) |
+                                (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), key);
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    int rest = findFirstScalar(data + i, n - i, value);
+    return rest < 0 ? -1 : i + rest;
+}
+
+__attribute__((target("avx2")))
+static int countMatchesAvx2(const int* data, int n, int value) {
+    __m256i key = _mm256_set1_epi32(value);
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), key));
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum) + countMatchesScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static int findAllAvx2(const int* data, int n, int value, int* positions) {
+    __m256i key = _mm256_set1_epi32(value);
+    int count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), key);
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        while (mask) {
+            positions[count++] = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    for (; i < n; i++)
+        if (data[i] == value)
+            positions[count++] = i;
+    return count;
+}
+
+#endif // SIMD_SEARCH_X86
+
+// Dispatch: the first call picks a kernel set, later calls use it directly
+static int findFirstDispatch(const int* data, int n, int value);
+static int countMatchesDispatch(const int* data, int n, int value);
+static int findAllDispatch(const int* data, int n, int value, int* positions);
+
+static int (*findFirst)(const int*, int, int) = findFirstDispatch;
+static int (*countMatches)(const int*, int, int) = countMatchesDispatch;
+static int (*findAll)(const int*, int, int, int*) = findAllDispatch;
+
+// Name of the kernel set in use: "avx2", "sse4.1" or "scalar"
+static const char* simdSearchLevel = "scalar";
+
+// Bind the kernel set; 'maxLevel' caps it (2 = AVX2, 1 = SSE4.1, 0 = scalar)
+static void selectSimdSearch(int maxLevel) {
+    findFirst = findFirstScalar;
+    countMatches = countMatchesScalar;
+    findAll = findAllScalar;
+    simdSearchLevel = "scalar";
+#ifdef SIMD_SEARCH_X86
+    __builtin_cpu_init();
+    if (maxLevel >= 2 && __builtin_cpu_supports("avx2")) {
+        findFirst = findFirstAvx2;
+        countMatches = countMatchesAvx2;
+        findAll = findAllAvx2;
+        simdSearchLevel = "avx2";
+    } else if (maxLevel >= 1 && __builtin_cpu_supports("sse4.1")) {
+        findFirst = findFirstSse4;
+        countMatches = countMatchesSse4;
+        findAll = findAllSse4;
+        simdSearchLevel = "sse4.1";
+    }
+#else
+    (void)maxLevel;
+#endif
+}
+
+static int findFirstDispatch(const int* data, int n, int value) {
+    selectSimdSearch(2);
+    return findFirst(data, n, value);
+}
+
+static int countMatchesDispatch(const int* data, int n, int value) {
+    selectSimdSearch(2);
+    return countMatches(data, n, value);
+}
+
+static int findAllDispatch(const int* data, int n, int value, int* positions) {
+    selectSimdSearch(2);
+    return findAll(data, n, value, positions);
+}
+
+#endif // SIMD_SEARCH_H
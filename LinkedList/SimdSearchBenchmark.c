@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>          // for clock_gettime()
+#include "SimdSearch.h"    // for findFirst(), countMatches() and findAll()
+
+#define ELEMENTS 16000000  // Values searched per pass
+#define PASSES 10          // Passes per measurement
+#define MISSING (-1)       // Value that is never stored, forces a full scan
+#define TARGET 7           // Value stored about once per 1000 elements
+
+// Node layout of SinglyLinkedList.c, for the current one-int-at-a-time loop
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The searchNode() loop from SinglyLinkedList.c without the printing
+static int searchList(struct Node* head, int value) {
+    int position = 1;
+    for (struct Node* temp = head; temp != NULL; temp = temp->next, position++)
+        if (temp->data == value)
+            return position;
+    return 0;
+}
+
+// Print GB/s for 'ns' spent scanning PASSES * ELEMENTS ints
+static void report(const char* name, double ns, long long result) {
+    double bytes = (double)PASSES * ELEMENTS * sizeof(int);
+    printf("  %-28s %7.2f ms/pass  %6.2f GB/s  (result %lld)\n",
+           name, ns / PASSES / 1e6, bytes / ns, result);
+}
+
+// Time the three kernels with the kernel set capped at 'level'
+static void benchmarkLevel(const int* data, int* positions, int level) {
+    long long result;
+    double start;
+    char name[64];
+
+    selectSimdSearch(level);
+
+    start = nowNs();
+    result = 0;
+    for (int p = 0; p < PASSES; p++)
+        result += findFirst(data, ELEMENTS, MISSING);
+    snprintf(name, sizeof(name), "%s findFirst (miss)", simdSearchLevel);
+    report(name, nowNs() - start, result);
+
+    start = nowNs();
+    result = 0;
+    for (int p = 0; p < PASSES; p++)
+        result += countMatches(data, ELEMENTS, TARGET);
+    snprintf(name, sizeof(name), "%s countMatches", simdSearchLevel);
+    report(name, nowNs() - start, result);
+
+    start = nowNs();
+    result = 0;
+    for (int p = 0; p < PASSES; p++)
+        result += findAll(data, ELEMENTS, TARGET, positions);
+    snprintf(name, sizeof(name), "%s findAll", simdSearchLevel);
+    report(name, nowNs() - start, result);
+}
+
+// Driver Code
+int main() {
+    int* data = (int*)malloc(ELEMENTS * sizeof(int));
+    int* positions = (int*)malloc(ELEMENTS * sizeof(int));
+    struct Node* nodes = (struct Node*)malloc(ELEMENTS * sizeof(struct Node));
+    unsigned int seed = 1;
+
+    for (int i = 0; i < ELEMENTS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (int)((seed >> 8) % 1000);
+        nodes[i].data = data[i];
+        nodes[i].next = i + 1 < ELEMENTS ? &nodes[i + 1] : NULL;
+    }
+
+    printf("%d ints, %d passes per row:\n", ELEMENTS, PASSES);
+
+    double start = nowNs();
+    long long result = 0;
+    for (int p = 0; p < PASSES; p++)
+        result += searchList(nodes, MISSING);
+    report("linked list searchNode loop", nowNs() - start, result);
+
+    for (int level = 0; level <= 2; level++)
+        benchmarkLevel(data, positions, level);
+
+    free(nodes);
+    free(positions);
+    free(data);
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine; a level the CPU lacks repeats the
+    best one it has):
+    -------------------------
+    16000000 ints, 10 passes per row:
+      linked list searchNode loop    51.75 ms/pass    1.24 GB/s  (result 0)
+      scalar findFirst (miss)        15.72 ms/pass    4.07 GB/s  (result -10)
+      scalar countMatches            17.12 ms/pass    3.74 GB/s  (result 159920)
+      scalar findAll                 21.37 ms/pass    2.99 GB/s  (result 159920)
+      sse4.1 findFirst (miss)        10.10 ms/pass    6.34 GB/s  (result -10)
+      sse4.1 countMatches             9.32 ms/pass    6.87 GB/s  (result 159920)
+      sse4.1 findAll                 13.36 ms/pass    4.79 GB/s  (result 159920)
+      avx2 findFirst (miss)           8.67 ms/pass    7.38 GB/s  (result -10)
+      avx2 countMatches               8.30 ms/pass    7.71 GB/s  (result 159920)
+      avx2 findAll                    8.74 ms/pass    7.32 GB/s  (result 159920)
+*/
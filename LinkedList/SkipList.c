@@ -0,0 +1,400 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>    // for uint32_t
+#include <time.h>      // for clock_gettime()
+
+#define MAX_LEVEL 16   // Enough for 4^16 elements with p = 1/4
+
+/*
+    Skip list: a sorted singly linked list with express lanes.
+
+    Level 0 is an ordinary sorted linked list. Each node is also linked into
+    levels 1..k-1 with probability 1/4 per level, so a search starts on the
+    sparse top level and drops down, skipping most nodes: insert, delete,
+    search, range scan and k-th element are O(log n) expected.
+
+    Nodes are allocated with exactly as many links as their level (flexible
+    array member), so three in four nodes carry a single link. With p = 1/4
+    the upper levels hold n/4, n/16, ... nodes, and the handful of nodes a
+    search touches there stays in cache between searches.
+
+    Each link also keeps a copy of the next node's value, so deciding whether
+    to move right reads the current node only; the next node is fetched just
+    when the search actually steps to it. That halves the cache misses per
+    level, and the link is still 16 bytes because the key fills padding.
+
+    The third field of a link is its span: how many level-0 nodes it jumps over.
+    Summing spans along the search path gives a node's rank, which makes
+    positions and kthElement() O(log n) as well.
+*/
+struct Link {
+    struct Node* next;
+    int span;                // Level-0 steps from this node to 'next'
+    int key;                 // Copy of next->data, fills the padding after 'span'
+};
+
+struct Node {
+    int data;
+    int level;               // Number of links, 1..MAX_LEVEL
+    struct Link links[];
+};
+
+// Skip list descriptor
+struct SkipList {
+    struct Node* head;       // Sentinel with MAX_LEVEL links, holds no value
+    int level;               // Highest level in use
+    int size;
+    uint32_t rng;            // State for randomLevel()
+};
+
+// Create a node with 'level' links
+struct Node* createNode(int value, int level) {
+    struct Node* newNode = (struct Node*)malloc(sizeof(struct Node) + level * sizeof(struct Link));
+    if (newNode == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    newNode->data = value;
+    newNode->level = level;
+    for (int i = 0; i < level; i++) {
+        newNode->links[i].next = NULL;
+        newNode->links[i].span = 0;
+        newNode->links[i].key = 0;
+    }
+    return newNode;
+}
+
+void initList(struct SkipList* list) {
+    list->head = createNode(0, MAX_LEVEL);
+    list->level = 1;
+    list->size = 0;
+    list->rng = 2463534242u;
+}
+
+// Level for a new node: each extra level with probability 1/4
+static int randomLevel(struct SkipList* list) {
+    // xorshift32
+    uint32_t x = list->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->rng = x;
+
+    int level = 1;
+    while ((x & 3) == 0 && level < MAX_LEVEL) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+// Insert without printing; equal values go after the existing ones
+static void insertValue(struct SkipList* list, int value) {
+    struct Node* update[MAX_LEVEL];
+    int rank[MAX_LEVEL];         // Rank of update[i]
+    struct Node* x = list->head;
+
+    for (int i = list->level - 1; i >= 0; i--) {
+        rank[i] = i == list->level - 1 ? 0 : rank[i + 1];
+        while (x->links[i].next != NULL && x->links[i].key <= value) {
+            rank[i] += x->links[i].span;
+            x = x->links[i].next;
+        }
+        update[i] = x;
+    }
+
+    int level = randomLevel(list);
+    if (level > list->level) {
+        for (int i = list->level; i < level; i++) {
+            rank[i] = 0;
+            update[i] = list->head;
+            list->head->links[i].span = list->size;
+        }
+        list->level = level;
+    }
+
+    struct Node* newNode = createNode(value, level);
+    for (int i = 0; i < level; i++) {
+        newNode->links[i].next = update[i]->links[i].next;
+        newNode->links[i].key = update[i]->links[i].key;
+        update[i]->links[i].next = newNode;
+        update[i]->links[i].key = value;
+        newNode->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+        update[i]->links[i].span = rank[0] - rank[i] + 1;
+    }
+    // Links above the new node now jump over one more node
+    for (int i = level; i < list->level; i++)
+        update[i]->links[i].span++;
+    list->size++;
+}
+
+// Delete one occurrence of 'value' without printing; returns 1 if found
+static int deleteValue(struct SkipList* list, int value) {
+    struct Node* update[MAX_LEVEL];
+    struct Node* x = list->head;
+
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL && x->links[i].key < value)
+            x = x->links[i].next;
+        update[i] = x;
+    }
+
+    x = x->links[0].next;
+    if (x == NULL || x->data != value)
+        return 0;
+
+    for (int i = 0; i < list->level; i++) {
+        if (update[i]->links[i].next == x) {
+            update[i]->links[i].span += x->links[i].span - 1;
+            update[i]->links[i].next = x->links[i].next;
+            update[i]->links[i].key = x->links[i].key;
+        } else {
+            update[i]->links[i].span--;
+        }
+    }
+    while (list->level > 1 && list->head->links[list->level - 1].next == NULL)
+        list->level--;
+    list->size--;
+    free(x);
+    return 1;
+}
+
+// Position (1-based) of the first occurrence of 'value', 0 if absent
+int findPosition(struct SkipList* list, int value) {
+    struct Node* x = list->head;
+    int rank = 0;
+
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL && x->links[i].key < value) {
+            rank += x->links[i].span;
+            x = x->links[i].next;
+        }
+    }
+    return x->links[0].next != NULL && x->links[0].key == value ? rank + 1 : 0;
+}
+
+// k-th smallest value (1-based); returns 0 if k is out of range
+int kthElement(struct SkipList* list, int k, int* value) {
+    struct Node* x = list->head;
+    int traversed = 0;
+
+    if (k < 1 || k > list->size)
+        return 0;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL && traversed + x->links[i].span <= k) {
+            traversed += x->links[i].span;
+            x = x->links[i].next;
+        }
+        if (traversed == k)
+            break;
+    }
+    *value = x->data;
+    return 1;
+}
+
+// Copy up to 'max' values in [low, high] into 'out'; returns how many were copied
+int rangeScan(struct SkipList* list, int low, int high, int* out, int max) {
+    struct Node* x = list->head;
+    int count = 0;
+
+    for (int i = list->level - 1; i >= 0; i--)
+        while (x->links[i].next != NULL && x->links[i].key < low)
+            x = x->links[i].next;
+    for (x = x->links[0].next; x != NULL && x->data <= high && count < max; x = x->links[0].next)
+        out[count++] = x->data;
+    return count;
+}
+
+// 1. Insert a value in sorted position
+void insertNode(struct SkipList* list, int value) {
+    insertValue(list, value);
+    printf("Inserted %d.\n", value);
+}
+
+// 2. Delete a node by value
+void deleteNode(struct SkipList* list, int value) {
+    if (deleteValue(list, value))
+        printf("Deleted node with value %d.\n", value);
+    else
+        printf("Value %d not found in the list.\n", value);
+}
+
+// 3. Search for an element
+void searchNode(struct SkipList* list, int value) {
+    int position = findPosition(list, value);
+    if (position > 0)
+        printf("Value %d found at position %d.\n", value, position);
+    else
+        printf("Value %d not found in the list.\n", value);
+}
+
+// 4. Display every level, top first
+void displayList(struct SkipList* list) {
+    if (list->size == 0) {
+        printf("The list is empty.\n");
+        return;
+    }
+    for (int i = list->level - 1; i >= 0; i--) {
+        printf("Level %d: ", i);
+        for (struct Node* x = list->head->links[i].next; x != NULL; x = x->links[i].next)
+            printf("%d -> ", x->data);
+        printf("NULL\n");
+    }
+}
+
+// 5. Free all nodes (cleanup)
+void freeList(struct SkipList* list) {
+    struct Node* x = list->head;
+    while (x != NULL) {
+        struct Node* next = x->links[0].next;
+        free(x);
+        x = next;
+    }
+    list->head = NULL;
+    list->size = 0;
+}
+
+/*
+    Benchmark: random inserts and searches against the sorted singly linked
+    list of SinglyLinkedList.c, where finding a value (and so inserting it in
+    order) is a walk from the head.
+*/
+struct PlainNode {
+    int data;
+    struct PlainNode* next;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int plainFind(struct PlainNode* head, int value) {
+    int position = 1;
+    for (struct PlainNode* node = head; node != NULL && node->data <= value; node = node->next, position++)
+        if (node->data == value)
+            return position;
+    return 0;
+}
+
+// Values 0, 2, 4, ... inserted in random order; searches hit odd and even values
+void benchmark(int n) {
+    struct SkipList list;
+    int* values = (int*)malloc(n * sizeof(int));
+    unsigned int seed = 99;
+    volatile long long sink = 0;
+
+    for (int i = 0; i < n; i++)
+        values[i] = 2 * i;
+    for (int i = n - 1; i > 0; i--) {
+        seed = seed * 1103515245u + 12345u;
+        int j = (int)((seed >> 8) % (unsigned int)(i + 1));
+        int t = values[i]; values[i] = values[j]; values[j] = t;
+    }
+
+    initList(&list);
+    double start = nowNs();
+    for (int i = 0; i < n; i++)
+        insertValue(&list, values[i]);
+    double insertNs = (nowNs() - start) / n;
+
+    int searches = 200000;
+    start = nowNs();
+    for (int s = 0; s < searches; s++) {
+        seed = seed * 1103515245u + 12345u;
+        sink += findPosition(&list, (int)((seed >> 8) % (unsigned int)(2 * n)));
+    }
+    double searchNs = (nowNs() - start) / searches;
+
+    // Sorted plain list, nodes allocated in order (its best case)
+    struct PlainNode* nodes = (struct PlainNode*)malloc(n * sizeof(struct PlainNode));
+    for (int i = 0; i < n; i++) {
+        nodes[i].data = 2 * i;
+        nodes[i].next = i + 1 < n ? &nodes[i + 1] : NULL;
+    }
+    int plainSearches = n >= 1000000 ? 20 : 20000000 / n;
+    start = nowNs();
+    for (int s = 0; s < plainSearches; s++) {
+        seed = seed * 1103515245u + 12345u;
+        sink += plainFind(nodes, (int)((seed >> 8) % (unsigned int)(2 * n)));
+    }
+    double plainNs = (nowNs() - start) / plainSearches;
+
+    printf("  %9d | %8.1f ns | %8.1f ns | %12.1f ns | %d\n",
+           n, insertNs, searchNs, plainNs, list.level);
+    free(nodes);
+    freeList(&list);
+    free(values);
+    (void)sink;
+}
+
+// Main function to test all operations
+int main() {
+    struct SkipList list;
+    int buffer[16], value;
+    initList(&list);
+
+    int demo[] = {30, 10, 50, 20, 40, 70, 60, 10};
+    for (int i = 0; i < 8; i++)
+        insertNode(&list, demo[i]);
+    displayList(&list);
+
+    searchNode(&list, 40);
+    searchNode(&list, 45);
+    if (kthElement(&list, 5, &value))
+        printf("5th smallest: %d\n", value);
+
+    int count = rangeScan(&list, 15, 55, buffer, 16);
+    printf("Values in [15, 55]:");
+    for (int i = 0; i < count; i++)
+        printf(" %d", buffer[i]);
+    printf("\n");
+
+    deleteNode(&list, 10);
+    deleteNode(&list, 70);
+    deleteNode(&list, 100);
+    displayList(&list);
+    printf("Size: %d values\n\n", list.size);
+    freeList(&list);
+
+    printf("  elements  |  insert     |  search     | linear search   | levels\n");
+    for (int n = 1000; n <= 10000000; n *= 10)
+        benchmark(n);
+    return 0;
+}
+
+/*
+    program output (timings depend on the machine):
+    ------------------------
+    Inserted 30.
+    Inserted 10.
+    Inserted 50.
+    Inserted 20.
+    Inserted 40.
+    Inserted 70.
+    Inserted 60.
+    Inserted 10.
+    Level 2: 50 -> NULL
+    Level 1: 50 -> NULL
+    Level 0: 10 -> 10 -> 20 -> 30 -> 40 -> 50 -> 60 -> 70 -> NULL
+    Value 40 found at position 5.
+    Value 45 not found in the list.
+    5th smallest: 40
+    Values in [15, 55]: 20 30 40 50
+    Deleted node with value 10.
+    Deleted node with value 70.
+    Value 100 not found in the list.
+    Level 2: 50 -> NULL
+    Level 1: 50 -> NULL
+    Level 0: 10 -> 20 -> 30 -> 40 -> 50 -> 60 -> NULL
+    Size: 6 values
+
+      elements  |  insert     |  search     | linear search   | levels
+           1000 |    200.6 ns |    101.8 ns |       1121.7 ns | 5
+          10000 |    229.6 ns |    164.1 ns |      10906.9 ns | 6
+         100000 |    443.3 ns |    665.5 ns |     112665.0 ns | 8
+        1000000 |   1934.4 ns |   2575.3 ns |    1365231.3 ns | 10
+       10000000 |   4859.4 ns |   6756.1 ns |   14659741.4 ns | 12
+*/
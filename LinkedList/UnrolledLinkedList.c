@@ -0,0 +1,395 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>      // for clock_gettime()
+#include "NodePool.h"  // for initAlignedPool(), poolAlloc() and poolFree()
+
+#define CACHE_LINE 64  // Size of one cache line in bytes
+
+// Number of ints that fit in one cache line next to the node header
+#define NODE_CAPACITY ((CACHE_LINE - sizeof(void*) - sizeof(int)) / sizeof(int))
+
+/*
+    Unrolled linked list.
+
+    Each node is exactly one cache line and stores up to NODE_CAPACITY ints
+    (13 on 64-bit targets) in a small array, so walking the list costs one
+    cache miss per 13 values instead of one per value, and the inner loop over
+    data[] is a fixed-width compare of all NODE_CAPACITY slots. The kernels
+    in SimdSearch.h are bound through function pointers, and an indirect
+    call per 13 ints costs more than a vector compare saves.
+
+    A full node is split in two halves on insert. After a delete, a node that
+    drops below half full borrows from or merges with its successor, so every
+    node except possibly the last stays at least half full.
+*/
+struct Node {
+    struct Node* next;
+    int count;                   // Values in use, 1..NODE_CAPACITY
+    int data[NODE_CAPACITY];
+};
+
+/*
+    List descriptor. Nodes come from the list's own pool with cache-line
+    aligned slabs, so nodes created one after another sit next to each other
+    in memory. One aligned_alloc() per node pads every 64-byte node to a
+    192-byte stride, which makes a forward walk fetch three times the memory
+    it needs. Freed nodes go on the pool's free list and are reused first.
+*/
+struct List {
+    struct Node* head;
+    struct Node* tail;
+    int size;                    // Total number of values
+    struct NodePool pool;        // Backs every node of this list
+};
+
+void initList(struct List* list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    initAlignedPool(&list->pool, sizeof(struct Node), CACHE_LINE);
+}
+
+// Function to create a new, empty node aligned to a cache line
+struct Node* createNode(struct List* list) {
+    struct Node* newNode = (struct Node*)poolAlloc(&list->pool);
+    newNode->next = NULL;
+    newNode->count = 0;
+    return newNode;
+}
+
+// Move the upper half of a full node into a new node right after it
+static void splitNode(struct List* list, struct Node* node) {
+    struct Node* newNode = createNode(list);
+    int half = node->count / 2;
+
+    for (int i = half; i < node->count; i++)
+        newNode->data[i - half] = node->data[i];
+    newNode->count = node->count - half;
+    node->count = half;
+
+    newNode->next = node->next;
+    node->next = newNode;
+    if (list->tail == node)
+        list->tail = newNode;
+}
+
+// Insert 'value' at index 'pos' inside 'node', splitting it first if it is full
+static void insertInNode(struct List* list, struct Node* node, int pos, int value) {
+    if (node->count == (int)NODE_CAPACITY) {
+        splitNode(list, node);
+        if (pos > node->count) {
+            pos -= node->count;
+            node = node->next;
+        }
+    }
+    for (int i = node->count; i > pos; i--)
+        node->data[i] = node->data[i - 1];
+    node->data[pos] = value;
+    node->count++;
+    list->size++;
+}
+
+// Keep 'node' at least half full by borrowing from or merging with its successor
+static void rebalance(struct List* list, struct Node* prev, struct Node* node) {
+    struct Node* next = node->next;
+
+    if (node->count == 0) {
+        // Node became empty: unlink it
+        if (prev == NULL)
+            list->head = next;
+        else
+            prev->next = next;
+        if (list->tail == node)
+            list->tail = prev;
+        poolFree(&list->pool, node);
+        return;
+    }
+    if (node->count >= (int)NODE_CAPACITY / 2 || next == NULL)
+        return;
+
+    if (node->count + next->count <= (int)NODE_CAPACITY) {
+        // Merge the successor into this node
+        for (int i = 0; i < next->count; i++)
+            node->data[node->count + i] = next->data[i];
+        node->count += next->count;
+        node->next = next->next;
+        if (list->tail == next)
+            list->tail = node;
+        poolFree(&list->pool, next);
+    } else {
+        // Borrow values from the front of the successor
+        int move = (next->count - node->count) / 2;
+        for (int i = 0; i < move; i++)
+            node->data[node->count + i] = next->data[i];
+        for (int i = move; i < next->count; i++)
+            next->data[i - move] = next->data[i];
+        node->count += move;
+        next->count -= move;
+    }
+}
+
+// 1. Insert at the beginning
+void insertAtBeginning(struct List* list, int value) {
+    if (list->head == NULL) {
+        list->head = list->tail = createNode(list);
+    }
+    insertInNode(list, list->head, 0, value);
+    printf("Inserted %d at the beginning.\n", value);
+}
+
+// Append without printing, shared by insertAtEnd() and bulk builds
+static void appendValue(struct List* list, int value) {
+    if (list->tail == NULL)
+        list->head = list->tail = createNode(list);
+    else if (list->tail->count == (int)NODE_CAPACITY) {
+        // Start a fresh node instead of splitting, so appended nodes stay full
+        struct Node* newNode = createNode(list);
+        list->tail->next = newNode;
+        list->tail = newNode;
+    }
+    list->tail->data[list->tail->count++] = value;
+    list->size++;
+}
+
+// 2. Insert at the end
+void insertAtEnd(struct List* list, int value) {
+    int wasEmpty = list->head == NULL;
+    appendValue(list, value);
+    if (wasEmpty)
+        printf("Inserted %d at the end (list was empty).\n", value);
+    else
+        printf("Inserted %d at the end.\n", value);
+}
+
+// 3. Insert after a given value
+void insertAfterValue(struct List* list, int afterValue, int newValue) {
+    for (struct Node* node = list->head; node != NULL; node = node->next) {
+        for (int i = 0; i < node->count; i++) {
+            if (node->data[i] == afterValue) {
+                insertInNode(list, node, i + 1, newValue);
+                printf("Inserted %d after %d.\n", newValue, afterValue);
+                return;
+            }
+        }
+    }
+    printf("Value %d not found in the list.\n", afterValue);
+}
+
+// 4. Delete a value (first occurrence)
+void deleteNode(struct List* list, int value) {
+    struct Node* prev = NULL;
+    for (struct Node* node = list->head; node != NULL; prev = node, node = node->next) {
+        for (int i = 0; i < node->count; i++) {
+            if (node->data[i] == value) {
+                for (int j = i + 1; j < node->count; j++)
+                    node->data[j - 1] = node->data[j];
+                node->count--;
+                list->size--;
+                rebalance(list, prev, node);
+                printf("Deleted node with value %d.\n", value);
+                return;
+            }
+        }
+    }
+    printf("Value %d not found in the list.\n", value);
+}
+
+// Index of 'value' in the node, -1 if absent. Every slot is compared without
+// branching, so the compiler can unroll or vectorize the constant-width loop;
+// slots past 'count' hold stale values and are masked off.
+static inline int findInNode(const struct Node* node, int value) {
+    unsigned int matches = 0;
+    for (int i = 0; i < (int)NODE_CAPACITY; i++)
+        matches |= (unsigned int)(node->data[i] == value) << i;
+    matches &= (1u << node->count) - 1;
+    return matches ? __builtin_ctz(matches) : -1;
+}
+
+// Position (1-based) of the first occurrence of 'value', 0 if absent
+int findPosition(struct List* list, int value) {
+    int base = 0;
+    for (struct Node* node = list->head; node != NULL; node = node->next) {
+        int i = findInNode(node, value);
+        if (i >= 0)
+            return base + i + 1;
+        base += node->count;
+    }
+    return 0;
+}
+
+// 5. Search for an element
+void searchNode(struct List* list, int value) {
+    int position = findPosition(list, value);
+    if (position > 0)
+        printf("Value %d found at position %d.\n", value, position);
+    else
+        printf("Value %d not found in the list.\n", value);
+}
+
+// 6. Display the list, one [...] group per node
+void displayList(struct List* list) {
+    if (list->head == NULL) {
+        printf("The list is empty.\n");
+        return;
+    }
+    printf("Unrolled List: ");
+    for (struct Node* node = list->head; node != NULL; node = node->next) {
+        printf("[");
+        for (int i = 0; i < node->count; i++)
+            printf(i ? " %d" : "%d", node->data[i]);
+        printf("] -> ");
+    }
+    printf("NULL\n");
+}
+
+// 7. Free all nodes in O(1); the pool keeps its slabs for reuse
+void freeList(struct List* list) {
+    poolReset(&list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+/*
+    Benchmark: the same values in a plain one-int-per-node list (the node
+    layout of SinglyLinkedList.c) and in the unrolled list. A long-running
+    process allocates list nodes in no particular order, so the plain list is
+    measured both with nodes linked in allocation order and with nodes linked
+    in shuffled order, which is what pointer chasing looks like on an aged heap.
+
+    Against in-order nodes the unrolled list is only about 2.5x faster: a
+    sequential walk over a contiguous array is already prefetched well, and
+    the gain is just the smaller footprint (one 64-byte line per 13 values
+    instead of 16 bytes per value). The large win, about 140x here, is over
+    shuffled nodes, where the plain list takes one cache miss per value.
+*/
+struct PlainNode {
+    int data;
+    struct PlainNode* next;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static struct PlainNode* buildPlainList(struct PlainNode* nodes, int n, int shuffled) {
+    int* order = (int*)malloc(n * sizeof(int));
+    unsigned int seed = 12345;
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    if (shuffled) {
+        for (int i = n - 1; i > 0; i--) {
+            seed = seed * 1103515245u + 12345u;
+            int j = (int)((seed >> 8) % (unsigned int)(i + 1));
+            int t = order[i]; order[i] = order[j]; order[j] = t;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        nodes[order[i]].data = i;
+        nodes[order[i]].next = i + 1 < n ? &nodes[order[i + 1]] : NULL;
+    }
+    struct PlainNode* head = &nodes[order[0]];
+    free(order);
+    return head;
+}
+
+static int plainFind(struct PlainNode* head, int value) {
+    int position = 1;
+    for (struct PlainNode* node = head; node != NULL; node = node->next, position++)
+        if (node->data == value)
+            return position;
+    return 0;
+}
+
+void benchmark(int n, int searches) {
+    struct PlainNode* nodes = (struct PlainNode*)malloc(n * sizeof(struct PlainNode));
+    struct List list;
+    volatile int sink = 0;
+
+    initList(&list);
+    for (int i = 0; i < n; i++)
+        appendValue(&list, i);
+
+    printf("%d elements, %d full-length searches:\n", n, searches);
+    for (int shuffled = 0; shuffled <= 1; shuffled++) {
+        struct PlainNode* head = buildPlainList(nodes, n, shuffled);
+        double start = nowNs();
+        for (int s = 0; s < searches; s++)
+            sink += plainFind(head, -1);
+        double ms = (nowNs() - start) / 1e6 / searches;
+        printf("  plain list, %-16s %8.2f ms per search\n",
+               shuffled ? "shuffled nodes" : "in-order nodes", ms);
+    }
+
+    double start = nowNs();
+    for (int s = 0; s < searches; s++)
+        sink += findPosition(&list, -1);
+    double ms = (nowNs() - start) / 1e6 / searches;
+    printf("  unrolled list                 %8.2f ms per search\n", ms);
+
+    freeList(&list);
+    destroyPool(&list.pool);
+    free(nodes);
+    (void)sink;
+}
+
+// Main function to test all operations
+int main() {
+    struct List list;
+    initList(&list);
+
+    insertAtBeginning(&list, 10);
+    insertAtBeginning(&list, 5);
+    for (int i = 20; i <= 150; i += 10)
+        insertAtEnd(&list, i);
+    displayList(&list);
+
+    insertAfterValue(&list, 10, 15);   // Splits the full first node
+    displayList(&list);
+
+    deleteNode(&list, 5);
+    deleteNode(&list, 10);
+    deleteNode(&list, 15);
+    deleteNode(&list, 20);             // Underfull node borrows or merges
+    displayList(&list);
+
+    searchNode(&list, 150);
+    searchNode(&list, 100);
+    deleteNode(&list, 7);
+    printf("Size: %d values\n\n", list.size);
+    freeList(&list);
+    destroyPool(&list.pool);
+
+    benchmark(4000000, 5);
+    return 0;
+}
+
+/*
+    program output (timings depend on the machine):
+    ------------------------
+    Inserted 10 at the beginning.
+    Inserted 5 at the beginning.
+    Inserted 20 at the end.
+    ...
+    Inserted 150 at the end.
+    Unrolled List: [5 10 20 30 40 50 60 70 80 90 100 110 120] -> [130 140 150] -> NULL
+    Inserted 15 after 10.
+    Unrolled List: [5 10 15 20 30 40 50] -> [60 70 80 90 100 110 120] -> [130 140 150] -> NULL
+    Deleted node with value 5.
+    Deleted node with value 10.
+    Deleted node with value 15.
+    Deleted node with value 20.
+    Unrolled List: [30 40 50 60 70 80 90 100 110 120] -> [130 140 150] -> NULL
+    Value 150 found at position 13.
+    Value 100 found at position 8.
+    Value 7 not found in the list.
+    Size: 13 values
+
+    4000000 elements, 5 full-length searches:
+      plain list, in-order nodes      12.53 ms per search
+      plain list, shuffled nodes     701.35 ms per search
+      unrolled list                     4.85 ms per search
+*/
@@ -0,0 +1,418 @@
+#define _DEFAULT_SOURCE     // for madvise() and mkstemp() under -std=c11
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>     // for memchr(), memcpy()
+#include <stdatomic.h>  // for atomic_fetch_add()
+#include <pthread.h>    // for pthread_create() and pthread_cond_t
+#include <fcntl.h>      // for open()
+#include <unistd.h>     // for close(), sysconf()
+#include <sys/mman.h>   // for mmap()
+#include <sys/stat.h>   // for fstat()
+#include <time.h>       // for clock_gettime()
+
+#define BLOCK_BYTES (256 * 1024)   // Input bytes per work item, cut at line boundaries
+#define MAX_THREADS 64
+#define LINES 4000000              // Expressions in the generated benchmark file
+
+/*
+    Batch evaluation of a file of postfix expressions, one per line.
+
+    The file is mapped with mmap() and cut into blocks of about BLOCK_BYTES.
+    Block k runs from the first line starting at or after k * BLOCK_BYTES to
+    the first line starting at or after (k + 1) * BLOCK_BYTES, so every line
+    belongs to exactly one block and no thread has to scan ahead for others.
+
+    A pool of threads takes block numbers from one atomic counter; each
+    thread evaluates with its own growable stack (no global stack[]/top)
+    and prints its results into a per-block buffer. The main thread writes
+    the buffers out in block order as they complete, so the output lines
+    are in input order while later blocks are still being evaluated.
+
+    Lines use the format of PostfixEvaluation.c: numbers and + - * / %
+    separated by spaces. A bad line prints an error on its output line
+    instead of ending the run.
+*/
+
+enum EvalStatus { EVAL_OK, EVAL_DIV_ZERO, EVAL_INVALID };
+
+// Per-thread evaluator state
+struct Evaluator {
+    int* stack;
+    int capacity;
+};
+
+// Growable output text of one block
+struct Output {
+    char* text;
+    size_t length, capacity;
+    long lines;
+};
+
+struct Batch {
+    const char* data;          // Mapped input
+    size_t size;
+    int blocks;
+    atomic_int nextBlock;      // Next block a worker takes
+    struct Output* outputs;    // One per block
+    char* done;                // done[k] once outputs[k] is complete
+    pthread_mutex_t lock;      // Guards 'done'
+    pthread_cond_t blockDone;
+};
+
+static void pushValue(struct Evaluator* e, int* top, int val) {
+    if (*top + 1 == e->capacity) {
+        int* stack = (int*)realloc(e->stack, 2 * e->capacity * sizeof(int));
+        if (stack == NULL) {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+        e->stack = stack;
+        e->capacity *= 2;
+    }
+    e->stack[++*top] = val;
+}
+
+// evaluatePostfix() over the bytes [p, end) with this thread's stack
+enum EvalStatus evaluateLine(struct Evaluator* e, const char* p, const char* end, int* result) {
+    int top = -1;
+
+    for (; p < end; p++) {
+        char ch = *p;
+        if (ch == ' ' || ch == '\r' || ch == '\t')
+            continue;
+        if (ch >= '0' && ch <= '9') {
+            unsigned int num = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+                num = num * 10 + (*p++ - '0');
+            p--;
+            pushValue(e, &top, (int)num);
+            continue;
+        }
+        if (top < 1)
+            return EVAL_INVALID;
+        int val2 = e->stack[top--];
+        int val1 = e->stack[top];
+        switch (ch) {
+            case '+': e->stack[top] = (int)((unsigned int)val1 + (unsigned int)val2); break;
+            case '-': e->stack[top] = (int)((unsigned int)val1 - (unsigned int)val2); break;
+            case '*': e->stack[top] = (int)((unsigned int)val1 * (unsigned int)val2); break;
+            case '/':
+            case '%':
+                if (val2 == 0)
+                    return EVAL_DIV_ZERO;
+                if (val2 == -1)
+                    e->stack[top] = ch == '%' ? 0 : (int)(0u - (unsigned int)val1);
+                else
+                    e->stack[top] = ch == '%' ? val1 % val2 : val1 / val2;
+                break;
+            default:
+                return EVAL_INVALID;
+        }
+    }
+    if (top != 0)
+        return EVAL_INVALID;
+    *result = e->stack[0];
+    return EVAL_OK;
+}
+
+// Append 'count' bytes to a block's output
+static void appendOutput(struct Output* out, const char* text, size_t count) {
+    if (out->length + count > out->capacity) {
+        size_t capacity = out->capacity ? 2 * out->capacity : 4096;
+        while (capacity < out->length + count)
+            capacity *= 2;
+        char* grown = (char*)realloc(out->text, capacity);
+        if (grown == NULL) {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+        out->text = grown;
+        out->capacity = capacity;
+    }
+    memcpy(out->text + out->length, text, count);
+    out->length += count;
+}
+
+// Append 'value' and a newline; faster than printf() for millions of lines
+static void appendResult(struct Output* out, int value) {
+    char digits[16];
+    int i = sizeof(digits);
+    unsigned int v = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    digits[--i] = '\n';
+    do {
+        digits[--i] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (value < 0)
+        digits[--i] = '-';
+    appendOutput(out, digits + i, sizeof(digits) - i);
+}
+
+// Offset of the first line that starts at or after 'pos'
+static size_t lineStart(const struct Batch* b, size_t pos) {
+    if (pos == 0)
+        return 0;
+    if (pos >= b->size)
+        return b->size;
+    const char* nl = (const char*)memchr(b->data + pos - 1, '\n', b->size - pos + 1);
+    return nl == NULL ? b->size : (size_t)(nl - b->data) + 1;
+}
+
+// Evaluate every line of block k into outputs[k]
+static void evaluateBlock(struct Batch* b, struct Evaluator* e, int k) {
+    const char* p = b->data + lineStart(b, (size_t)k * BLOCK_BYTES);
+    const char* end = b->data + lineStart(b, (size_t)(k + 1) * BLOCK_BYTES);
+    struct Output* out = &b->outputs[k];
+
+    while (p < end) {
+        const char* nl = (const char*)memchr(p, '\n', end - p);
+        const char* lineEnd = nl == NULL ? end : nl;
+        int result;
+        switch (evaluateLine(e, p, lineEnd, &result)) {
+            case EVAL_OK:       appendResult(out, result); break;
+            case EVAL_DIV_ZERO: appendOutput(out, "Division by zero error!\n", 24); break;
+            case EVAL_INVALID:  appendOutput(out, "Invalid expression\n", 19); break;
+        }
+        out->lines++;
+        p = lineEnd + 1;
+    }
+}
+
+static void* worker(void* arg) {
+    struct Batch* b = (struct Batch*)arg;
+    struct Evaluator e;
+    e.capacity = 64;
+    e.stack = (int*)malloc(e.capacity * sizeof(int));
+    if (e.stack == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+
+    for (;;) {
+        int k = atomic_fetch_add(&b->nextBlock, 1);
+        if (k >= b->blocks)
+            break;
+        evaluateBlock(b, &e, k);
+        pthread_mutex_lock(&b->lock);
+        b->done[k] = 1;
+        pthread_cond_broadcast(&b->blockDone);
+        pthread_mutex_unlock(&b->lock);
+    }
+    free(e.stack);
+    return NULL;
+}
+
+/*
+    Evaluate every line of the file at 'path' with 'threads' threads and
+    write one result line per input line to 'out'. Returns the number of
+    lines, -1 if the file cannot be read.
+*/
+long evaluateFile(const char* path, FILE* out, int threads) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        printf("Cannot open %s\n", path);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    struct Batch b;
+    b.size = st.st_size;
+    if (b.size == 0) {
+        close(fd);
+        return 0;
+    }
+    b.data = (const char*)mmap(NULL, b.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (b.data == MAP_FAILED) {
+        printf("Cannot map %s\n", path);
+        return -1;
+    }
+    madvise((void*)b.data, b.size, MADV_SEQUENTIAL);
+
+    b.blocks = (int)((b.size + BLOCK_BYTES - 1) / BLOCK_BYTES);
+    atomic_init(&b.nextBlock, 0);
+    b.outputs = (struct Output*)calloc(b.blocks, sizeof(struct Output));
+    b.done = (char*)calloc(b.blocks, 1);
+    if (b.outputs == NULL || b.done == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    pthread_mutex_init(&b.lock, NULL);
+    pthread_cond_init(&b.blockDone, NULL);
+
+    pthread_t pool[MAX_THREADS];
+    for (int i = 0; i < threads; i++)
+        pthread_create(&pool[i], NULL, worker, &b);
+
+    // Write blocks in order while the pool works on later ones
+    long lines = 0;
+    for (int k = 0; k < b.blocks; k++) {
+        pthread_mutex_lock(&b.lock);
+        while (!b.done[k])
+            pthread_cond_wait(&b.blockDone, &b.lock);
+        pthread_mutex_unlock(&b.lock);
+        fwrite(b.outputs[k].text, 1, b.outputs[k].length, out);
+        lines += b.outputs[k].lines;
+        free(b.outputs[k].text);
+    }
+
+    for (int i = 0; i < threads; i++)
+        pthread_join(pool[i], NULL);
+    pthread_mutex_destroy(&b.lock);
+    pthread_cond_destroy(&b.blockDone);
+    free(b.outputs);
+    free(b.done);
+    munmap((void*)b.data, b.size);
+    return lines;
+}
+
+/*
+    Today's way for comparison: fgets() one line at a time, evaluate it on a
+    global stack like PostfixEvaluation.c, printf() the result.
+*/
+#define SIZE 100
+
+int stack[SIZE];
+int top = -1;
+
+int evaluatePostfix(const char* expr, int* result) {
+    top = -1;
+    for (int i = 0; expr[i] != '\0'; i++) {
+        char ch = expr[i];
+        if (ch == ' ' || ch == '\n' || ch == '\r')
+            continue;
+        if (ch >= '0' && ch <= '9') {
+            unsigned int num = 0;
+            while (expr[i] >= '0' && expr[i] <= '9')
+                num = num * 10 + (expr[i++] - '0');
+            i--;
+            if (top >= SIZE - 1) return EVAL_INVALID;
+            stack[++top] = (int)num;
+            continue;
+        }
+        if (top < 1) return EVAL_INVALID;
+        int val2 = stack[top--];
+        int val1 = stack[top];
+        switch (ch) {
+            case '+': stack[top] = (int)((unsigned int)val1 + (unsigned int)val2); break;
+            case '-': stack[top] = (int)((unsigned int)val1 - (unsigned int)val2); break;
+            case '*': stack[top] = (int)((unsigned int)val1 * (unsigned int)val2); break;
+            case '/':
+            case '%':
+                if (val2 == 0) return EVAL_DIV_ZERO;
+                if (val2 == -1) stack[top] = ch == '%' ? 0 : (int)(0u - (unsigned int)val1);
+                else stack[top] = ch == '%' ? val1 % val2 : val1 / val2;
+                break;
+            default:
+                return EVAL_INVALID;
+        }
+    }
+    if (top != 0) return EVAL_INVALID;
+    *result = stack[0];
+    return EVAL_OK;
+}
+
+long evaluateSequential(FILE* in, FILE* out) {
+    char line[SIZE * 8];
+    long lines = 0;
+    int result;
+    while (fgets(line, sizeof(line), in) != NULL) {
+        switch (evaluatePostfix(line, &result)) {
+            case EVAL_OK:       fprintf(out, "%d\n", result); break;
+            case EVAL_DIV_ZERO: fprintf(out, "Division by zero error!\n"); break;
+            case EVAL_INVALID:  fprintf(out, "Invalid expression\n"); break;
+        }
+        lines++;
+    }
+    return lines;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// FNV-1a over a whole file, to check that every run wrote the same output
+static unsigned long long hashFile(FILE* f) {
+    unsigned long long h = 14695981039346656037ull;
+    int ch;
+    rewind(f);
+    while ((ch = getc(f)) != EOF)
+        h = (h ^ (unsigned char)ch) * 1099511628211ull;
+    return h;
+}
+
+// Write LINES random postfix expressions, a few of them dividing by zero
+void generateFile(const char* path) {
+    FILE* f = fopen(path, "w");
+    const char* operators = "+-*/%+-*";
+    srand(11);
+    for (long i = 0; i < LINES; i++) {
+        int operands = 2 + rand() % 5;
+        fprintf(f, "%d", rand() % 1000);
+        for (int k = 1; k < operands; k++)
+            fprintf(f, " %d %c", rand() % 100, operators[rand() % 8]);
+        putc('\n', f);
+    }
+    fclose(f);
+}
+
+// Driver Code: "BatchEvaluator file [threads]" evaluates a file to stdout;
+// without arguments, benchmarks a generated file
+int main(int argc, char* argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1) {
+        int threads = argc > 2 ? atoi(argv[2]) : (int)cores;
+        if (threads < 1) threads = 1;
+        if (threads > MAX_THREADS) threads = MAX_THREADS;
+        return evaluateFile(argv[1], stdout, threads) < 0;
+    }
+
+    char path[] = "/tmp/batchXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("Cannot create a temporary file\n");
+        return 1;
+    }
+    close(fd);
+    generateFile(path);
+
+    FILE* in = fopen(path, "r");
+    fseek(in, 0, SEEK_END);
+    printf("%d expressions, %.1f MB, %ld core(s) online\n", LINES, ftell(in) / 1e6, cores);
+    rewind(in);
+
+    FILE* out = tmpfile();
+    double start = nowNs();
+    long lines = evaluateSequential(in, out);
+    double ns = nowNs() - start;
+    unsigned long long expected = hashFile(out);
+    printf("  fgets + global stack: %7.1f ms, %6.1f M lines/s\n", ns / 1e6, lines / ns * 1e3);
+    fclose(out);
+    fclose(in);
+
+    for (int threads = 1; threads <= 8 && threads <= MAX_THREADS; threads *= 2) {
+        out = tmpfile();
+        start = nowNs();
+        lines = evaluateFile(path, out, threads);
+        ns = nowNs() - start;
+        printf("  mmap, %d thread(s):    %7.1f ms, %6.1f M lines/s  (%s)\n", threads, ns / 1e6,
+               lines / ns * 1e3, hashFile(out) == expected ? "same output" : "OUTPUT DIFFERS");
+        fclose(out);
+    }
+    remove(path);
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine and core count):
+    --------------------------------
+    4000000 expressions, 74.4 MB, 1 core(s) online
+      fgets + global stack:   812.2 ms,    4.9 M lines/s
+      mmap, 1 thread(s):      588.8 ms,    6.8 M lines/s  (same output)
+      mmap, 2 thread(s):      560.1 ms,    7.1 M lines/s  (same output)
+      mmap, 4 thread(s):      455.0 ms,    8.8 M lines/s  (same output)
+      mmap, 8 thread(s):      429.3 ms,    9.3 M lines/s  (same output)
+*/
@@ -0,0 +1,288 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>  // for strlen(), memcpy()
+#include <ctype.h>   // for isdigit(), isalpha(), isalnum(), isspace()
+#include <limits.h>  // for INT_MIN, INT_MAX
+
+/*
+    Expression bytecode shared by the expression programs in this folder.
+
+    compileExpression() runs the infix-to-postfix conversion of
+    InfixToPostfix.c once and stores the result as two parallel arrays,
+    one opcode and one int operand per instruction:
+
+        "(a + 2) * b"   ->   VAR a | CONST 2 | ADD | VAR b | MUL
+
+    Operands are multi-digit integers and named variables; each distinct
+    name gets an index into the binding array passed to runProgram().
+    Operators are + - * / % ^ and unary minus, with the precedence of
+    InfixToPostfix.c (^ above * / % above + -); ^ is right-associative and
+    unary minus binds tighter than * but looser than ^, so -a^2 is -(a^2).
+
+    runProgram() is the evaluatePostfix() loop over the arrays: no parsing
+    and no allocation, the caller passes a stack of p->maxDepth ints. It
+    returns a status instead of exiting. Arithmetic is on int like
+    evaluatePostfix(); + - * wrap around instead of being undefined on
+    overflow, and a negative exponent truncates like integer division.
+
+    DUP, LOAD and STORE only come out of the optimizer (Optimizer.h): STORE
+    copies the top of the stack into a reuse slot, LOAD pushes it back.
+    Reuse slots sit at the bottom of the stack, below the operands.
+*/
+
+#define BC_MAX_NAME 32   // Longest variable name + 1
+
+enum OpCode { OP_CONST, OP_VAR, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_POW, OP_NEG,
+              OP_DUP, OP_LOAD, OP_STORE };
+
+// runProgram() only returns the first two; the others are for callers that also compile
+enum ExprStatus { EXPR_OK, EXPR_DIV_ZERO, EXPR_SYNTAX_ERROR, EXPR_UNBOUND_VARIABLE };
+
+struct Program {
+    int length;                  // Instructions
+    int maxDepth;                // Stack slots runProgram() needs, reuse slots included
+    int slotCount;               // Reuse slots for LOAD/STORE
+    unsigned char* ops;          // enum OpCode per instruction
+    int* operands;               // Constant, variable index or reuse slot, 0 for operators
+    int varCount;
+    char (*varNames)[BC_MAX_NAME];
+};
+
+// Precedence on the operator stack; '~' is unary minus
+static inline int bcPrecedence(char op) {
+    if (op == '^') return 4;
+    if (op == '~') return 3;
+    if (op == '*' || op == '/' || op == '%') return 2;
+    if (op == '+' || op == '-') return 1;
+    return 0;
+}
+
+static inline enum OpCode bcOpCode(char op) {
+    switch (op) {
+        case '+': return OP_ADD;
+        case '-': return OP_SUB;
+        case '*': return OP_MUL;
+        case '/': return OP_DIV;
+        case '%': return OP_MOD;
+        case '^': return OP_POW;
+        default:  return OP_NEG;
+    }
+}
+
+// Index of variable 'name' in the program, -1 if the formula does not use it
+static inline int findVariable(const struct Program* p, const char* name) {
+    for (int i = 0; i < p->varCount; i++)
+        if (strcmp(p->varNames[i], name) == 0)
+            return i;
+    return -1;
+}
+
+// Append one instruction and track the stack depth it leaves behind
+static inline void bcEmit(struct Program* p, enum OpCode op, int operand, int* depth) {
+    p->ops[p->length] = (unsigned char)op;
+    p->operands[p->length] = operand;
+    p->length++;
+    if (op == OP_CONST || op == OP_VAR || op == OP_DUP || op == OP_LOAD)
+        (*depth)++;
+    else if (op != OP_NEG && op != OP_STORE)
+        (*depth)--;
+    if (*depth > p->maxDepth)
+        p->maxDepth = *depth;
+}
+
+static inline void freeProgram(struct Program* p) {
+    if (p == NULL) return;
+    free(p->ops);
+    free(p->operands);
+    free(p->varNames);
+    free(p);
+}
+
+// Compile an infix expression. Returns NULL on a syntax error and stores
+// the offset of the offending character in *errorPos (if not NULL).
+static inline struct Program* compileExpression(const char* infix, int* errorPos) {
+    size_t n = strlen(infix);
+    struct Program* p = (struct Program*)calloc(1, sizeof(struct Program));
+    char* opStack = (char*)malloc(n + 1);
+    int top = -1, depth = 0, expectOperand = 1, varCapacity = 0;
+    size_t i = 0;
+
+    if (p == NULL || opStack == NULL)
+        goto fail;
+    // Every token emits at most one instruction
+    p->ops = (unsigned char*)malloc(n + 1);
+    p->operands = (int*)malloc((n + 1) * sizeof(int));
+    if (p->ops == NULL || p->operands == NULL)
+        goto fail;
+
+    while (i < n) {
+        char ch = infix[i];
+
+        if (isspace((unsigned char)ch)) {
+            i++;
+        } else if (isdigit((unsigned char)ch)) {
+            long long num = 0;
+            if (!expectOperand) goto fail;
+            while (i < n && isdigit((unsigned char)infix[i])) {
+                num = num * 10 + (infix[i++] - '0');
+                if (num > INT_MAX) goto fail;
+            }
+            bcEmit(p, OP_CONST, (int)num, &depth);
+            expectOperand = 0;
+        } else if (isalpha((unsigned char)ch) || ch == '_') {
+            char name[BC_MAX_NAME];
+            size_t len = 0;
+            if (!expectOperand) goto fail;
+            while (i < n && (isalnum((unsigned char)infix[i]) || infix[i] == '_')) {
+                if (len == BC_MAX_NAME - 1) goto fail;
+                name[len++] = infix[i++];
+            }
+            name[len] = '\0';
+            int index = findVariable(p, name);
+            if (index < 0) {
+                if (p->varCount == varCapacity) {
+                    varCapacity = varCapacity ? 2 * varCapacity : 8;
+                    char (*names)[BC_MAX_NAME] = (char (*)[BC_MAX_NAME])realloc(p->varNames, varCapacity * BC_MAX_NAME);
+                    if (names == NULL) goto fail;
+                    p->varNames = names;
+                }
+                index = p->varCount++;
+                memcpy(p->varNames[index], name, len + 1);
+            }
+            bcEmit(p, OP_VAR, index, &depth);
+            expectOperand = 0;
+        } else if (ch == '(') {
+            if (!expectOperand) goto fail;
+            opStack[++top] = ch;
+            i++;
+        } else if (ch == ')') {
+            if (expectOperand) goto fail;
+            while (top >= 0 && opStack[top] != '(')
+                bcEmit(p, bcOpCode(opStack[top--]), 0, &depth);
+            if (top < 0) goto fail;       // No matching '('
+            top--;
+            i++;
+        } else if (expectOperand && (ch == '-' || ch == '+')) {
+            // Unary sign: prefix operators never pop anything
+            if (ch == '-')
+                opStack[++top] = '~';
+            i++;
+        } else if (bcPrecedence(ch) > 0 && ch != '~') {
+            if (expectOperand) goto fail;
+            // Pop tighter operators, and equal ones unless 'ch' is right-associative
+            while (top >= 0 && opStack[top] != '(' &&
+                   (bcPrecedence(opStack[top]) > bcPrecedence(ch) ||
+                    (bcPrecedence(opStack[top]) == bcPrecedence(ch) && ch != '^')))
+                bcEmit(p, bcOpCode(opStack[top--]), 0, &depth);
+            opStack[++top] = ch;
+            expectOperand = 1;
+            i++;
+        } else {
+            goto fail;
+        }
+    }
+    if (expectOperand) goto fail;         // Empty input or trailing operator
+    while (top >= 0) {
+        if (opStack[top] == '(') goto fail;
+        bcEmit(p, bcOpCode(opStack[top--]), 0, &depth);
+    }
+    free(opStack);
+    return p;
+
+fail:
+    if (errorPos != NULL)
+        *errorPos = (int)i;
+    free(opStack);
+    freeProgram(p);
+    return NULL;
+}
+
+// Integer power by squaring; a negative exponent truncates toward zero
+static inline int bcPower(int base, int exp) {
+    unsigned int result = 1, b = (unsigned int)base;
+    if (exp < 0)
+        return base == 1 ? 1 : base == -1 ? (exp & 1 ? -1 : 1) : 0;
+    while (exp) {
+        if (exp & 1) result *= b;
+        b *= b;
+        exp >>= 1;
+    }
+    return (int)result;
+}
+
+// Evaluate 'p' with vars[i] bound to variable i; 'stack' holds p->maxDepth ints.
+// With GCC/Clang each handler jumps straight to the next one through a label
+// table (threaded code), which predicts far better than one shared switch.
+static inline enum ExprStatus runProgram(const struct Program* p, const int* vars, int* stack, int* result) {
+    const unsigned char* ops = p->ops;
+    const int* operands = p->operands;
+    const int n = p->length;
+    int* sp = stack + p->slotCount;       // One past the top element
+    int pc = 0;
+
+#if defined(__GNUC__)
+    static const void* const handlers[] = {
+        &&opConst, &&opVar, &&opAdd, &&opSub, &&opMul, &&opDiv, &&opMod, &&opPow, &&opNeg,
+        &&opDup, &&opLoad, &&opStore
+    };
+#define BC_NEXT if (++pc == n) goto done; goto *handlers[ops[pc]]
+#define BC_CASE(code, label) label
+    goto *handlers[ops[0]];
+#else
+#define BC_NEXT if (++pc == n) goto done; goto dispatch
+#define BC_CASE(code, label) case code
+dispatch:
+    switch (ops[pc]) {
+#endif
+    BC_CASE(OP_CONST, opConst): *sp++ = operands[pc]; BC_NEXT;
+    BC_CASE(OP_VAR, opVar):     *sp++ = vars[operands[pc]]; BC_NEXT;
+    BC_CASE(OP_ADD, opAdd): sp--; sp[-1] = (int)((unsigned int)sp[-1] + (unsigned int)sp[0]); BC_NEXT;
+    BC_CASE(OP_SUB, opSub): sp--; sp[-1] = (int)((unsigned int)sp[-1] - (unsigned int)sp[0]); BC_NEXT;
+    BC_CASE(OP_MUL, opMul): sp--; sp[-1] = (int)((unsigned int)sp[-1] * (unsigned int)sp[0]); BC_NEXT;
+    BC_CASE(OP_DIV, opDiv):
+        sp--;
+        if (sp[0] == 0) return EXPR_DIV_ZERO;
+        sp[-1] = sp[0] == -1 ? (int)(0u - (unsigned int)sp[-1]) : sp[-1] / sp[0];
+        BC_NEXT;
+    BC_CASE(OP_MOD, opMod):
+        sp--;
+        if (sp[0] == 0) return EXPR_DIV_ZERO;
+        sp[-1] = sp[0] == -1 ? 0 : sp[-1] % sp[0];
+        BC_NEXT;
+    BC_CASE(OP_POW, opPow): sp--; sp[-1] = bcPower(sp[-1], sp[0]); BC_NEXT;
+    BC_CASE(OP_NEG, opNeg): sp[-1] = (int)(0u - (unsigned int)sp[-1]); BC_NEXT;
+    BC_CASE(OP_DUP, opDup):     *sp = sp[-1]; sp++; BC_NEXT;
+    BC_CASE(OP_LOAD, opLoad):   *sp++ = stack[operands[pc]]; BC_NEXT;
+    BC_CASE(OP_STORE, opStore): stack[operands[pc]] = sp[-1]; BC_NEXT;
+#if !defined(__GNUC__)
+    }
+#endif
+#undef BC_NEXT
+#undef BC_CASE
+
+done:
+    *result = sp[-1];
+    return EXPR_OK;
+}
+
+// Print the program as a space-separated postfix string ("neg" for unary minus,
+// "dup", "load N" and "store N" for the optimizer's instructions)
+static inline void printProgram(const struct Program* p) {
+    static const char symbols[] = "??+-*/%^";
+    for (int pc = 0; pc < p->length; pc++) {
+        if (pc) printf(" ");
+        if (p->ops[pc] == OP_CONST) printf("%d", p->operands[pc]);
+        else if (p->ops[pc] == OP_VAR) printf("%s", p->varNames[p->operands[pc]]);
+        else if (p->ops[pc] == OP_NEG) printf("neg");
+        else if (p->ops[pc] == OP_DUP) printf("dup");
+        else if (p->ops[pc] == OP_LOAD) printf("load %d", p->operands[pc]);
+        else if (p->ops[pc] == OP_STORE) printf("store %d", p->operands[pc]);
+        else printf("%c", symbols[p->ops[pc]]);
+    }
+    printf("\n");
+}
+
+#endif // BYTECODE_H
@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>     // for memcpy()
+#include <time.h>       // for clock_gettime()
+#include "Bytecode.h"   // for compileExpression() and runProgram()
+
+#define BLOCK 1024      // Rows per block; a few stack blocks of ints stay in L1
+#define ROWS (1 << 16)  // Rows per benchmark column: 256 KB, stays in L2
+#define PASSES 320      // Benchmark passes over the columns
+
+/*
+    Column-wise expression evaluation.
+
+    runProgram() evaluates one row at a time, so every row pays for the
+    instruction dispatch. Here the same bytecode is run over a block of
+    BLOCK rows at once: each stack entry is a whole block of values, and
+    each instruction is one tight loop over the block.
+
+        a b c * +    ->   slot0 = column a      (no copy)
+                          slot1 = column b
+                          slot2 = column c
+                          slot1 = slot1 * slot2 (BLOCK multiplies)
+                          slot0 = slot0 + slot1 (BLOCK additions)
+
+    + - * and unary minus use GCC vector extensions, so the loops compile
+    to SIMD instructions on any target without intrinsics. / % and ^ stay
+    scalar: x86 has no integer vector division, and every divisor must be
+    checked for zero anyway.
+*/
+
+// LANES ints per vector; may_alias and aligned(4) allow loads from any int array
+typedef unsigned int VecInt __attribute__((vector_size(32), aligned(4), may_alias));
+#define LANES (int)(sizeof(VecInt) / sizeof(int))
+
+// dst[i] = a[i] OP b[i] for one block; dst may be 'a'. Wraps like runProgram().
+#define BLOCK_OP(name, OP) \
+static void name(int* dst, const int* a, const int* b, int n) { \
+    int i = 0; \
+    for (; i + LANES <= n; i += LANES) \
+        *(VecInt*)(dst + i) = *(const VecInt*)(a + i) OP *(const VecInt*)(b + i); \
+    for (; i < n; i++) \
+        dst[i] = (int)((unsigned int)a[i] OP (unsigned int)b[i]); \
+}
+
+BLOCK_OP(addBlock, +)
+BLOCK_OP(subBlock, -)
+BLOCK_OP(mulBlock, *)
+
+static void negBlock(int* dst, const int* a, int n) {
+    int i = 0;
+    for (; i + LANES <= n; i += LANES)
+        *(VecInt*)(dst + i) = -*(const VecInt*)(a + i);
+    for (; i < n; i++)
+        dst[i] = (int)(0u - (unsigned int)a[i]);
+}
+
+// Checked scalar division; returns 0 if some divisor is zero
+static int divBlock(int* dst, const int* a, const int* b, int n, int modulo) {
+    for (int i = 0; i < n; i++) {
+        if (b[i] == 0)
+            return 0;
+        if (b[i] == -1)
+            dst[i] = modulo ? 0 : (int)(0u - (unsigned int)a[i]);
+        else
+            dst[i] = modulo ? a[i] % b[i] : a[i] / b[i];
+    }
+    return 1;
+}
+
+static void powBlock(int* dst, const int* a, const int* b, int n) {
+    for (int i = 0; i < n; i++)
+        dst[i] = bcPower(a[i], b[i]);
+}
+
+/*
+    A block failed somewhere, but instructions run column by column, so the
+    first failing instruction need not be in the first failing row. Redo the
+    block row by row; returns that row, with the rows before it in 'out'.
+*/
+static int firstFailingRow(const struct Program* p, const int* const* columns, int* out, int base, int n) {
+    int* stack = (int*)malloc(p->maxDepth * sizeof(int));
+    int* vars = (int*)malloc((p->varCount + 1) * sizeof(int));
+    int r = base;
+    if (stack == NULL || vars == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    for (; r < base + n; r++) {
+        for (int v = 0; v < p->varCount; v++)
+            vars[v] = columns[v][r];
+        if (runProgram(p, vars, stack, &out[r]) != EXPR_OK)
+            break;
+    }
+    free(vars);
+    free(stack);
+    return r;
+}
+
+/*
+    Evaluate 'p' for rows 0..rows-1: columns[v] holds the values of variable v
+    and out[r] receives the result of row r. On division by zero returns
+    EXPR_DIV_ZERO with the first such row in *errorRow; rows before it are done.
+*/
+enum ExprStatus evaluateColumns(const struct Program* p, const int* const* columns, int* out, int rows, int* errorRow) {
+    int constCount = 0;
+    for (int pc = 0; pc < p->length; pc++)
+        constCount += p->ops[pc] == OP_CONST;
+
+    // Reuse slot blocks, one block per stack depth for results, then one
+    // pre-filled block per constant
+    int* scratch = (int*)malloc((size_t)(p->maxDepth + constCount) * BLOCK * sizeof(int));
+    const int** slots = (const int**)malloc(p->maxDepth * sizeof(int*));
+    int* stackBlocks = scratch + (size_t)p->slotCount * BLOCK;
+    if (scratch == NULL || slots == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    int* constBlocks = scratch + (size_t)p->maxDepth * BLOCK;
+    for (int pc = 0, k = 0; pc < p->length; pc++)
+        if (p->ops[pc] == OP_CONST) {
+            for (int i = 0; i < BLOCK; i++)
+                constBlocks[k * BLOCK + i] = p->operands[pc];
+            k++;
+        }
+
+    enum ExprStatus status = EXPR_OK;
+    for (int base = 0; base < rows && status == EXPR_OK; base += BLOCK) {
+        int n = rows - base < BLOCK ? rows - base : BLOCK;
+        int sp = 0, k = 0;
+
+        for (int pc = 0; pc < p->length; pc++) {
+            int op = p->ops[pc];
+            if (op == OP_CONST) {
+                slots[sp++] = constBlocks + (size_t)k++ * BLOCK;
+                continue;
+            }
+            if (op == OP_VAR) {
+                slots[sp++] = columns[p->operands[pc]] + base;
+                continue;
+            }
+            if (op == OP_DUP) {
+                slots[sp] = slots[sp - 1];
+                sp++;
+                continue;
+            }
+            if (op == OP_LOAD) {
+                // Copied: the optimizer may store into the slot again while this is on the stack
+                int* dst = stackBlocks + (size_t)sp * BLOCK;
+                memcpy(dst, scratch + (size_t)p->operands[pc] * BLOCK, n * sizeof(int));
+                slots[sp++] = dst;
+                continue;
+            }
+            if (op == OP_STORE) {
+                memcpy(scratch + (size_t)p->operands[pc] * BLOCK, slots[sp - 1], n * sizeof(int));
+                continue;
+            }
+            if (op == OP_NEG) {
+                int* dst = stackBlocks + (size_t)(sp - 1) * BLOCK;
+                negBlock(dst, slots[sp - 1], n);
+                slots[sp - 1] = dst;
+                continue;
+            }
+
+            // Binary operator: the result replaces the left operand's slot
+            sp--;
+            int* dst = stackBlocks + (size_t)(sp - 1) * BLOCK;
+            const int* a = slots[sp - 1];
+            const int* b = slots[sp];
+            int ok = 1;
+            switch (op) {
+                case OP_ADD: addBlock(dst, a, b, n); break;
+                case OP_SUB: subBlock(dst, a, b, n); break;
+                case OP_MUL: mulBlock(dst, a, b, n); break;
+                case OP_DIV: ok = divBlock(dst, a, b, n, 0); break;
+                case OP_MOD: ok = divBlock(dst, a, b, n, 1); break;
+                case OP_POW: powBlock(dst, a, b, n); break;
+            }
+            if (!ok) {
+                int row = firstFailingRow(p, columns, out, base, n);
+                if (errorRow != NULL)
+                    *errorRow = row;
+                status = EXPR_DIV_ZERO;
+                break;
+            }
+            slots[sp - 1] = dst;
+        }
+        if (status == EXPR_OK)
+            memcpy(out + base, slots[0], n * sizeof(int));
+    }
+
+    free(slots);
+    free(scratch);
+    return status;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Operators per row: arithmetic instructions only
+static int rowOps(const struct Program* p) {
+    int count = 0;
+    for (int pc = 0; pc < p->length; pc++)
+        count += p->ops[pc] >= OP_ADD && p->ops[pc] <= OP_NEG;
+    return count;
+}
+
+// Point bound[i] at the column of the program's variable i; names are "a", "b", "c"
+static void bindColumns(const struct Program* p, int* const* columns, const int** bound) {
+    const char* names[] = {"a", "b", "c"};
+    for (int v = 0; v < 3; v++) {
+        int index = findVariable(p, names[v]);
+        if (index >= 0)
+            bound[index] = columns[v];
+    }
+}
+
+// Evaluate 'infix' over ROWS rows per pass, row by row and column-wise
+void benchmark(const char* infix, int* const* columns, int* out) {
+    struct Program* p = compileExpression(infix, NULL);
+    const int* bound[3];
+    int* stack = (int*)malloc(p->maxDepth * sizeof(int));
+    int* expected = (int*)malloc(ROWS * sizeof(int));
+    int vars[3];
+
+    bindColumns(p, columns, bound);
+    double start = nowNs();
+    for (int pass = 0; pass < PASSES; pass++)
+        for (int r = 0; r < ROWS; r++) {
+            for (int v = 0; v < p->varCount; v++)
+                vars[v] = bound[v][r];
+            runProgram(p, vars, stack, &expected[r]);
+        }
+    double rowWise = (nowNs() - start) / ((double)PASSES * ROWS);
+
+    start = nowNs();
+    for (int pass = 0; pass < PASSES; pass++)
+        evaluateColumns(p, bound, out, ROWS, NULL);
+    double columnWise = (nowNs() - start) / ((double)PASSES * ROWS);
+
+    int same = memcmp(out, expected, ROWS * sizeof(int)) == 0;
+    printf("  %-26s row %5.2f ns, column %5.2f ns per row, %4.1fx, %5.2f billion row-ops/s  (%s)\n",
+           infix, rowWise, columnWise, rowWise / columnWise, rowOps(p) / columnWise,
+           same ? "same results" : "MISMATCH");
+    free(expected);
+    free(stack);
+    freeProgram(p);
+}
+
+// Driver Code
+int main() {
+    int* columns[3];
+    int* out = (int*)malloc(ROWS * sizeof(int));
+    for (int v = 0; v < 3; v++)
+        columns[v] = (int*)malloc(ROWS * sizeof(int));
+    if (out == NULL || columns[0] == NULL || columns[1] == NULL || columns[2] == NULL) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+
+    // Small example: 10 rows, a b c = r, r % 4, 10 - r
+    for (int r = 0; r < 10; r++) {
+        columns[0][r] = r;
+        columns[1][r] = r % 4;
+        columns[2][r] = 10 - r;
+    }
+    const char* formulas[] = {"a * a + b - c", "(a + 1) * -c", "a / (b - 3)"};
+    for (int f = 0; f < 3; f++) {
+        int errorRow;
+        const int* bound[3];
+        struct Program* p = compileExpression(formulas[f], NULL);
+        bindColumns(p, columns, bound);
+        printf("%-14s ->", formulas[f]);
+        if (evaluateColumns(p, bound, out, 10, &errorRow) == EXPR_OK) {
+            for (int r = 0; r < 10; r++)
+                printf(" %d", out[r]);
+            printf("\n");
+        } else {
+            printf(" Division by zero error at row %d!\n", errorRow);
+        }
+        freeProgram(p);
+    }
+
+    srand(42);
+    for (int r = 0; r < ROWS; r++) {
+        columns[0][r] = rand() % 100000;
+        columns[1][r] = rand() % 1000;
+        columns[2][r] = rand() % 100 + 1;
+    }
+    printf("\n%d rows x %d passes, %d-row blocks, %d lanes per vector:\n", ROWS, PASSES, BLOCK, LANES);
+    benchmark("a + b * c", columns, out);
+    benchmark("a * 3 + b * 5 - c * 7", columns, out);
+    benchmark("(a - b) * (a + b) - -c", columns, out);
+    benchmark("(a + b) / c + a % c", columns, out);
+
+    for (int v = 0; v < 3; v++)
+        free(columns[v]);
+    free(out);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    a * a + b - c  -> -10 -7 -2 5 10 21 34 49 62 81
+    (a + 1) * -c   -> -10 -18 -24 -28 -30 -30 -28 -24 -18 -10
+    a / (b - 3)    -> Division by zero error at row 3!
+
+    65536 rows x 320 passes, 1024-row blocks, 8 lanes per vector:
+      a + b * c                  row 11.83 ns, column  0.57 ns per row, 20.6x,  3.49 billion row-ops/s  (same results)
+      a * 3 + b * 5 - c * 7      row 21.78 ns, column  1.28 ns per row, 17.0x,  3.91 billion row-ops/s  (same results)
+      (a - b) * (a + b) - -c     row 20.73 ns, column  1.06 ns per row, 19.6x,  4.73 billion row-ops/s  (same results)
+      (a + b) / c + a % c        row 21.08 ns, column  4.98 ns per row,  4.2x,  0.80 billion row-ops/s  (same results)
+*/
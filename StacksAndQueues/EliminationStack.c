@@ -0,0 +1,392 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>     // for uint64_t
+#include <stdatomic.h>  // for atomic_compare_exchange_strong_explicit()
+#include <pthread.h>    // for pthread_create()
+#include <time.h>       // for clock_gettime()
+
+#define STACK_CAPACITY 65536     // Nodes in the pool (maximum stack size)
+#define ELIMINATION_SLOTS 32     // Size of the elimination array
+#define MIN_SPIN 16              // Shortest time a push waits for a partner
+#define MAX_SPIN 1024            // Longest time a push waits for a partner
+#define OPS_PER_THREAD 1000000   // Operations per benchmark thread
+#define MAX_THREADS 64
+#define NIL 0xFFFFFFFFu          // Index meaning "no node"
+
+// Result of a stack operation
+enum StackStatus {
+    STACK_OK = 0,
+    STACK_OVERFLOW,
+    STACK_UNDERFLOW
+};
+
+/*
+    Treiber stack with an elimination-backoff array in front of it.
+
+    The stack itself is the one from TreiberStack.c: pool nodes addressed by
+    32-bit index and a tagged top word that defeats ABA. When the CAS on top
+    fails, the thread does not retry right away but backs off into the
+    elimination array. A push parks its value in a random slot and waits a
+    little; a pop that lands on a parked value takes it. The pair completes
+    without touching top, which is linearizable because a push immediately
+    followed by a pop leaves the stack unchanged.
+
+    Each thread adapts how wide a part of the array it uses and how long a
+    push waits: a timeout with nobody arriving shrinks the range (partners are
+    scarce, concentrate them), finding a slot busy widens it (too many threads
+    for too few slots), and the wait grows after timeouts and shrinks after
+    successful exchanges.
+*/
+struct StackNode {
+    int value;
+    atomic_uint next;    // Index of the node below, NIL at the bottom
+};
+
+struct EliminationStack {
+    atomic_ullong top;       // (tag << 32) | index
+    atomic_ullong freeList;  // (tag << 32) | index
+    struct StackNode* nodes;
+    // One exchanger per cache line so slots do not false-share
+    struct {
+        _Alignas(64) atomic_ullong word;
+    } slots[ELIMINATION_SLOTS];
+    atomic_ullong eliminated;  // Push/pop pairs completed in the array
+};
+
+// Exchanger word: state in bits 62-63, stamp in bits 32-61, value in bits 0-31
+#define SLOT_EMPTY   0ull
+#define SLOT_WAITING 1ull        // A push is parked with its value
+#define SLOT_TAKEN   2ull        // A pop took the parked value
+#define STAMP_MASK   0x3FFFFFFFull
+
+static inline uint64_t slotState(uint64_t w) { return w >> 62; }
+static inline uint64_t slotStamp(uint64_t w) { return (w >> 32) & STAMP_MASK; }
+
+static inline uint64_t makeSlot(uint64_t state, uint64_t stamp, int value) {
+    return state << 62 | (stamp & STAMP_MASK) << 32 | (uint32_t)value;
+}
+
+// Per-thread backoff state
+struct Backoff {
+    unsigned int range;   // Number of slots in use, 1..ELIMINATION_SLOTS
+    unsigned int spin;    // How long a push waits for a partner
+    uint64_t rng;         // xorshift state for slot selection
+};
+
+static _Thread_local struct Backoff backoff = {ELIMINATION_SLOTS / 4, MIN_SPIN * 4, 0};
+
+static unsigned int randomSlot(void) {
+    if (backoff.rng == 0)
+        backoff.rng = (uint64_t)(uintptr_t)&backoff | 1;
+    backoff.rng ^= backoff.rng << 13;
+    backoff.rng ^= backoff.rng >> 7;
+    backoff.rng ^= backoff.rng << 17;
+    return (unsigned int)(backoff.rng % backoff.range);
+}
+
+static void onTimeout(void) {
+    if (backoff.range > 1) backoff.range--;
+    if (backoff.spin < MAX_SPIN) backoff.spin *= 2;
+}
+
+static void onCollision(void) {
+    if (backoff.range < ELIMINATION_SLOTS) backoff.range++;
+}
+
+static void onExchange(void) {
+    if (backoff.spin > MIN_SPIN) backoff.spin /= 2;
+}
+
+static inline void cpuRelax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static inline unsigned int indexOf(uint64_t word) { return (unsigned int)word; }
+
+static inline uint64_t makeWord(uint64_t oldWord, unsigned int index) {
+    return ((oldWord >> 32) + 1) << 32 | index;
+}
+
+// Push node 'index' onto the tagged list at *head (free list: retry until it sticks)
+static void pushIndex(struct EliminationStack* s, atomic_ullong* head, unsigned int index) {
+    uint64_t old = atomic_load_explicit(head, memory_order_relaxed);
+    do {
+        atomic_store_explicit(&s->nodes[index].next, indexOf(old), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(head, &old, makeWord(old, index),
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+// Pop a node index from the tagged list at *head, NIL if it is empty
+static unsigned int popIndex(struct EliminationStack* s, atomic_ullong* head) {
+    uint64_t old = atomic_load_explicit(head, memory_order_acquire);
+    for (;;) {
+        unsigned int index = indexOf(old);
+        if (index == NIL)
+            return NIL;
+        unsigned int next = atomic_load_explicit(&s->nodes[index].next, memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(head, &old, makeWord(old, next),
+                                                  memory_order_acquire, memory_order_acquire))
+            return index;
+    }
+}
+
+// Create a stack that can hold up to 'capacity' elements
+struct EliminationStack* createStack(unsigned int capacity) {
+    struct EliminationStack* s = (struct EliminationStack*)aligned_alloc(64, sizeof(struct EliminationStack));
+    if (s == NULL)
+        return NULL;
+    s->nodes = (struct StackNode*)malloc(capacity * sizeof(struct StackNode));
+    if (s->nodes == NULL) {
+        free(s);
+        return NULL;
+    }
+    for (unsigned int i = 0; i < capacity; i++)
+        atomic_init(&s->nodes[i].next, i + 1 < capacity ? i + 1 : NIL);
+    atomic_init(&s->freeList, capacity > 0 ? 0 : NIL);
+    atomic_init(&s->top, NIL);
+    for (int i = 0; i < ELIMINATION_SLOTS; i++)
+        atomic_init(&s->slots[i].word, SLOT_EMPTY);
+    atomic_init(&s->eliminated, 0);
+    return s;
+}
+
+// Release the stack; no other thread may be using it
+void freeStack(struct EliminationStack* s) {
+    if (s == NULL) return;
+    free(s->nodes);
+    free(s);
+}
+
+// Park 'x' in the elimination array; returns 1 if a pop took it
+static int tryEliminatePush(struct EliminationStack* s, int x) {
+    atomic_ullong* slot = &s->slots[randomSlot()].word;
+    uint64_t seen = atomic_load_explicit(slot, memory_order_relaxed);
+
+    if (slotState(seen) != SLOT_EMPTY) {
+        onCollision();
+        return 0;
+    }
+    uint64_t offer = makeSlot(SLOT_WAITING, slotStamp(seen) + 1, x);
+    if (!atomic_compare_exchange_strong_explicit(slot, &seen, offer,
+                                                 memory_order_release, memory_order_relaxed)) {
+        onCollision();
+        return 0;
+    }
+
+    for (unsigned int i = 0; i < backoff.spin; i++) {
+        if (atomic_load_explicit(slot, memory_order_acquire) != offer)
+            break;
+        cpuRelax();
+    }
+
+    // Withdraw the offer; if that fails, a pop has already taken the value
+    uint64_t expected = offer;
+    if (atomic_compare_exchange_strong_explicit(slot, &expected, makeSlot(SLOT_EMPTY, slotStamp(offer), 0),
+                                                memory_order_relaxed, memory_order_relaxed)) {
+        onTimeout();
+        return 0;
+    }
+    // Only the owning push moves a slot out of TAKEN, so a plain store is enough
+    atomic_store_explicit(slot, makeSlot(SLOT_EMPTY, slotStamp(offer), 0), memory_order_release);
+    onExchange();
+    return 1;
+}
+
+// Take a parked push value from the elimination array; returns 1 on success
+static int tryEliminatePop(struct EliminationStack* s, int* x) {
+    atomic_ullong* slot = &s->slots[randomSlot()].word;
+    uint64_t seen = atomic_load_explicit(slot, memory_order_acquire);
+
+    if (slotState(seen) != SLOT_WAITING) {
+        onTimeout();
+        return 0;
+    }
+    if (!atomic_compare_exchange_strong_explicit(slot, &seen, makeSlot(SLOT_TAKEN, slotStamp(seen), 0),
+                                                 memory_order_acq_rel, memory_order_relaxed)) {
+        onCollision();
+        return 0;
+    }
+    *x = (int)(uint32_t)seen;
+    atomic_fetch_add_explicit(&s->eliminated, 1, memory_order_relaxed);
+    onExchange();
+    return 1;
+}
+
+// Push operation: Adds an element to the top of the stack
+enum StackStatus push(struct EliminationStack* s, int x) {
+    unsigned int index = popIndex(s, &s->freeList);
+    if (index == NIL)
+        return STACK_OVERFLOW;
+    s->nodes[index].value = x;
+
+    uint64_t old = atomic_load_explicit(&s->top, memory_order_relaxed);
+    for (;;) {
+        atomic_store_explicit(&s->nodes[index].next, indexOf(old), memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&s->top, &old, makeWord(old, index),
+                                                  memory_order_release, memory_order_relaxed))
+            return STACK_OK;
+        // Contention on top: try to meet a pop instead
+        if (tryEliminatePush(s, x)) {
+            pushIndex(s, &s->freeList, index);
+            return STACK_OK;
+        }
+        old = atomic_load_explicit(&s->top, memory_order_relaxed);
+    }
+}
+
+// Pop operation: Removes the top element into *x
+enum StackStatus pop(struct EliminationStack* s, int* x) {
+    uint64_t old = atomic_load_explicit(&s->top, memory_order_acquire);
+    for (;;) {
+        unsigned int index = indexOf(old);
+        if (index == NIL)
+            return STACK_UNDERFLOW;
+        unsigned int next = atomic_load_explicit(&s->nodes[index].next, memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&s->top, &old, makeWord(old, next),
+                                                  memory_order_acquire, memory_order_acquire)) {
+            *x = s->nodes[index].value;
+            pushIndex(s, &s->freeList, index);
+            return STACK_OK;
+        }
+        // Contention on top: try to meet a push instead
+        if (tryEliminatePop(s, x))
+            return STACK_OK;
+        old = atomic_load_explicit(&s->top, memory_order_acquire);
+    }
+}
+
+// Peek operation: Reads the top element without removing it (snapshot)
+enum StackStatus peek(struct EliminationStack* s, int* x) {
+    for (;;) {
+        uint64_t old = atomic_load_explicit(&s->top, memory_order_acquire);
+        if (indexOf(old) == NIL)
+            return STACK_UNDERFLOW;
+        int value = s->nodes[indexOf(old)].value;
+        if (atomic_load_explicit(&s->top, memory_order_acquire) == old) {
+            *x = value;
+            return STACK_OK;
+        }
+    }
+}
+
+// isEmpty operation: Checks if the stack is empty (snapshot)
+int isEmpty(struct EliminationStack* s) {
+    return indexOf(atomic_load_explicit(&s->top, memory_order_acquire)) == NIL;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Benchmark worker: balanced random mix of pushes and pops on the shared stack
+struct Worker {
+    pthread_t thread;
+    struct EliminationStack* s;
+    unsigned int seed;
+    long long pushed;
+    long long popped;
+};
+
+static void* worker(void* arg) {
+    struct Worker* w = (struct Worker*)arg;
+    unsigned int seed = w->seed;
+    long long pushed = 0, popped = 0;
+    int x;
+
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if (seed & 0x10000) {
+            if (push(w->s, i & 0xFFFF) == STACK_OK)
+                pushed += i & 0xFFFF;
+        } else if (pop(w->s, &x) == STACK_OK) {
+            popped += x;
+        }
+    }
+    w->pushed = pushed;
+    w->popped = popped;
+    return NULL;
+}
+
+// Run the balanced benchmark with 'threads' threads and print throughput
+void benchmark(int threads) {
+    struct EliminationStack* s = createStack(STACK_CAPACITY);
+    struct Worker workers[MAX_THREADS];
+    long long pushed = 0, popped = 0;
+    int i, x;
+
+    double start = nowNs();
+    for (i = 0; i < threads; i++) {
+        workers[i].s = s;
+        workers[i].seed = 2654435761u * (i + 1);
+        pthread_create(&workers[i].thread, NULL, worker, &workers[i]);
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        pushed += workers[i].pushed;
+        popped += workers[i].popped;
+    }
+    double elapsed = nowNs() - start;
+
+    // Whatever was pushed and not popped must still be on the stack
+    while (pop(s, &x) == STACK_OK)
+        popped += x;
+
+    printf("%3d thread(s): %8.2f Mops/s  eliminated %6.2f%%  %s\n", threads,
+           (double)OPS_PER_THREAD * threads / elapsed * 1e3,
+           100.0 * atomic_load(&s->eliminated) / ((double)OPS_PER_THREAD * threads / 2),
+           pushed == popped ? "ok" : "CHECKSUM MISMATCH");
+    freeStack(s);
+}
+
+// Driver Code: optional argument is the highest thread count to benchmark
+int main(int argc, char* argv[]) {
+    struct EliminationStack* s = createStack(2);
+    int maxThreads = argc > 1 ? atoi(argv[1]) : 16;
+    int x;
+
+    if (maxThreads < 1) maxThreads = 1;
+    if (maxThreads > MAX_THREADS) maxThreads = MAX_THREADS;
+
+    push(s, 10);      // Push 10
+    push(s, 20);      // Push 20
+    if (push(s, 30) == STACK_OVERFLOW)
+        printf("Stack Overflow, 30 not pushed\n");
+
+    if (peek(s, &x) == STACK_OK)
+        printf("Top element is %d\n", x); // Should print 20
+
+    while (pop(s, &x) == STACK_OK)
+        printf("Popped element is %d\n", x);
+
+    if (isEmpty(s))
+        printf("Stack is empty\n");
+    freeStack(s);
+
+    printf("\nBalanced push/pop, %d operations per thread:\n", OPS_PER_THREAD);
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+        benchmark(threads);
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine and core count; elimination only
+    kicks in when threads really run in parallel and collide on top):
+    -------------------------
+    Stack Overflow, 30 not pushed
+    Top element is 20
+    Popped element is 20
+    Popped element is 10
+    Stack is empty
+
+    Balanced push/pop, 1000000 operations per thread:
+      1 thread(s):    36.41 Mops/s  eliminated   0.00%  ok
+      2 thread(s):    37.16 Mops/s  eliminated   0.00%  ok
+      4 thread(s):    38.70 Mops/s  eliminated   0.00%  ok
+      8 thread(s):    37.76 Mops/s  eliminated   0.00%  ok
+     16 thread(s):    42.06 Mops/s  eliminated   0.00%  ok
+*/
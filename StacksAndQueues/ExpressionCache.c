@@ -0,0 +1,850 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>     // for uint32_t, uint64_t
+#include <string.h>     // for strlen(), memcmp(), memset()
+#include <ctype.h>      // for isspace(), isdigit(), isalpha()
+#include <math.h>       // for pow()
+#include <time.h>       // for clock_gettime()
+#include "Bytecode.h"   // for compileExpression() and runProgram()
+#include "Optimizer.h"  // for optimizeProgram()
+#include "../LinkedList/OpenAddressing.h"  // for homeSlot() and probeRemove()
+
+#define LATENCY_SAMPLE 64     // Time one lookup in this many
+#define SPELLING_MAX 256      // Longer spellings are normalized on every lookup
+
+/*
+    Memoizing front end for the expression compiler.
+
+    The same formula strings arrive again and again, often spelled with
+    different spacing. A formula is normalized into its key: whitespace is
+    dropped (one space is kept between two adjacent names or numbers, so
+    "a 2" stays different from "a2") and leading zeros are stripped from
+    numbers, so "( x + 007 ) * y" and "(x+7)*y" give the same key. The key
+    is hashed eight bytes at a time, and the hash selects a slot in an open
+    addressing table of entry indices (linear probing and backward-shift
+    removal from OpenAddressing.h, as in LRUCache.c).
+
+    Normalizing costs about as much as a compile on its own, so the raw
+    spellings are hashed first (one multiply per eight bytes) and looked
+    up in an array of spelling slots, a set of two per table slot. A
+    slot holds the full text of a spelling that led to an entry and names
+    that entry together with its generation, which changes whenever the
+    entry is refilled, so a slot left behind by an eviction simply misses.
+    A repeated spelling of a cached formula therefore costs a hash and a
+    memcmp(). The slots sit outside the byte budget, like the table, and
+    keep spellings of up to SPELLING_MAX bytes.
+
+    Admission: a spelling that misses its set and whose hash is not in
+    the 'seen' array (one hash per slot, overwritten on collision) is only
+    recorded there and compiled as it is into a scratch entry that is not
+    kept, which costs about what the caller would pay without the cache.
+    The array is used as a window of as many slots as entries have been
+    handed out so far (rounded up to a power of two), so it remembers
+    about as many formulas as the cache holds. Only a second sighting
+    within that window, or a spelling whose slot went stale, is normalized
+    and looked up, so a new spelling of a cached formula misses once
+    before it finds the entry. A formula not cached yet is inserted only
+    if every victim it needs is cold (see below); otherwise it stays in
+    the scratch entry. Keeping only formulas that come back, and only in
+    place of ones that stopped coming, spares the misses the mallocs and
+    the eviction of something that was still in use.
+
+    An entry starts with the plain compiled program and is optimized
+    (optimizeProgram()) on the first hit that finds its CLOCK count already
+    raised, i.e. once it has been hit twice, keeping the plain program if
+    the optimized one is not shorter.
+
+    When the formula has no variables the program is also run once on
+    insert and the value, or the division error, is kept, so a hit on a
+    constant-only formula skips the evaluation too. Syntax errors are
+    cached as well; their position refers to the entry's key, which is the
+    raw spelling for an entry that was not kept.
+
+    Memory is bounded by an entry count and a byte budget covering the key,
+    the bytecode and the bookkeeping. When either would be exceeded, CLOCK
+    picks victims: a hand sweeps the entries handed out so far, and every
+    entry carries a count from 0 to 3 that a hit raises and the hand
+    lowers as it passes; an entry found at 0 is cold. A hit only bumps the
+    count, so nothing is relinked as in LRUCache.c. An insert that needs
+    room looks at the entry under the hand: a cold one is evicted, a warm
+    one is aged by one and the insert is dropped, so a burst of one-off
+    formulas wears a popular entry down by one step per miss rather than
+    flushing it. New entries start at 0, so a formula not hit since its
+    insert goes first.
+
+    Counters: hits, misses, evictions, and the latency of every 64th lookup
+    (hits and misses apart), since timing each one would cost about as
+    much as a hit.
+*/
+
+struct CacheEntry {
+    uint64_t hash;
+    char* key;                  // Normalized formula, the raw spelling in c->uncached
+    int keyLength;
+    struct Program* program;    // Bytecode, NULL on a syntax error
+    int optimized;              // 'program' went through optimizeProgram() (or needs not)
+    int errorPos;               // Syntax error offset in 'key', -1 if none
+    int isConstant;             // No variables: 'status' and 'value' are final
+    enum ExprStatus status;
+    int value;
+    int referenced;             // CLOCK count, 0-3, raised by every hit
+    int used;
+    unsigned generation;        // Changes on every insert, for the spelling slots
+    size_t bytes;               // Charged against the byte budget
+};
+
+// A raw spelling and the entry it normalized to
+struct Spelling {
+    uint64_t hash;              // hashKey() of the raw text
+    char* text;
+    int length;
+    int capacity;               // Size of 'text'
+    int entry;                  // Entry index, valid while its generation matches
+    unsigned generation;
+};
+
+struct ExprCache {
+    struct CacheEntry* entries; // The CLOCK ring
+    int capacity;
+    int count;
+    int hand;
+    int highWater;              // Entries [0, highWater) have been handed out at least once
+    int* freeEntries;           // Unused entry indices
+    int freeCount;
+    int* table;                 // Open addressing over entry indices, -1 empty
+    uint32_t mask;              // Table size - 1
+    int shift;                  // 32 - log2(table size)
+    uint64_t* seen;             // Admission filter: hashes missed once, by home slot
+    int seenShift;              // 32 - log2(slots of 'seen' in use)
+    struct Spelling* spellings; // Two-slot sets, one per table slot, by the top bits of the raw hash
+    unsigned generation;        // Last generation handed out
+    size_t bytes;
+    size_t maxBytes;
+    struct CacheEntry uncached; // Last miss that was not kept
+    char* key;                  // Normalized text of the current lookup
+    size_t keyCapacity;
+    int* vars;                  // Bindings and stack for evaluateEntry()
+    int* stack;
+    int varCapacity;
+    int stackCapacity;
+    long long hits;
+    long long misses;
+    long long evictions;
+    long long lookups;
+    long long timedHits;
+    long long timedMisses;
+    double hitNs;               // Total over the timed lookups
+    double missNs;
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void* checkedAlloc(void* ptr) {
+    if (ptr == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+enum CharClass { CHAR_OTHER, CHAR_SPACE, CHAR_DIGIT, CHAR_NAME };
+
+// Character classes for normalize(), one table lookup per byte instead of several ctype calls
+static unsigned char charClass[256];
+
+static void initCharClass(void) {
+    for (int ch = 0; ch < 256; ch++)
+        charClass[ch] = isspace(ch) ? CHAR_SPACE : isdigit(ch) ? CHAR_DIGIT :
+                        isalpha(ch) || ch == '_' ? CHAR_NAME : CHAR_OTHER;
+}
+
+// Create a cache of at most 'capacity' formulas and 'maxBytes' bytes, NULL on failure
+struct ExprCache* createCache(int capacity, size_t maxBytes) {
+    struct ExprCache* c = (struct ExprCache*)calloc(1, sizeof(struct ExprCache));
+    uint32_t tableSize = 4;
+
+    if (c == NULL || capacity <= 0) {
+        free(c);
+        return NULL;
+    }
+    while (tableSize < 2 * (uint32_t)capacity)
+        tableSize <<= 1;
+    c->entries = (struct CacheEntry*)calloc(capacity, sizeof(struct CacheEntry));
+    c->freeEntries = (int*)malloc(capacity * sizeof(int));
+    c->table = (int*)malloc(tableSize * sizeof(int));
+    c->seen = (uint64_t*)calloc(tableSize, sizeof(uint64_t));
+    c->spellings = (struct Spelling*)calloc(2 * tableSize, sizeof(struct Spelling));
+    if (c->entries == NULL || c->freeEntries == NULL || c->table == NULL || c->seen == NULL ||
+        c->spellings == NULL) {
+        free(c->entries);
+        free(c->freeEntries);
+        free(c->table);
+        free(c->seen);
+        free(c->spellings);
+        free(c);
+        return NULL;
+    }
+    memset(c->table, 0xff, tableSize * sizeof(int));
+    initCharClass();
+    c->mask = tableSize - 1;
+    c->shift = hashShift(tableSize);
+    c->seenShift = hashShift(4);
+    c->capacity = capacity;
+    c->maxBytes = maxBytes;
+    // Hand out low indices first
+    for (int i = capacity - 1; i >= 0; i--)
+        c->freeEntries[c->freeCount++] = i;
+    return c;
+}
+
+static void clearEntry(struct CacheEntry* entry) {
+    free(entry->key);
+    freeProgram(entry->program);
+    memset(entry, 0, sizeof(struct CacheEntry));
+}
+
+// Drop the scratch entry; its key is c->key, which it does not own
+static void clearScratch(struct ExprCache* c) {
+    c->uncached.key = NULL;
+    clearEntry(&c->uncached);
+}
+
+void freeCache(struct ExprCache* c) {
+    if (c == NULL) return;
+    for (int i = 0; i < c->capacity; i++)
+        clearEntry(&c->entries[i]);
+    clearScratch(c);
+    free(c->entries);
+    free(c->freeEntries);
+    free(c->table);
+    free(c->seen);
+    for (uint32_t i = 0; i <= 2 * c->mask + 1; i++)
+        free(c->spellings[i].text);
+    free(c->spellings);
+    free(c->key);
+    free(c->vars);
+    free(c->stack);
+    free(c);
+}
+
+// Multiply-xorshift over eight-byte words: one multiply per word, not per byte
+static uint64_t hashKey(const char* key, int n) {
+    uint64_t h = (uint64_t)n * 0x9e3779b97f4a7c15ull, word;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        memcpy(&word, key + i, 8);
+        h = (h ^ word) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+    }
+    word = 0;
+    memcpy(&word, key + i, n - i);
+    h = (h ^ word) * 0xc4ceb9fe1a85ec53ull;
+    return h ^ h >> 29;
+}
+
+// c->key with room for 'need' bytes
+static char* reserveKey(struct ExprCache* c, size_t need) {
+    if (need > c->keyCapacity) {
+        c->keyCapacity = 2 * need;
+        c->key = (char*)checkedAlloc(realloc(c->key, c->keyCapacity));
+    }
+    return c->key;
+}
+
+// Normalize 'infix' ('length' bytes) into c->key and hash it; returns the key length
+static int normalize(struct ExprCache* c, const char* infix, size_t length, uint64_t* hash) {
+    char* key = reserveKey(c, length + 1);   // Normalizing never makes the text longer
+
+    // Branch-free: every byte is stored and the flags only move the output
+    // index. Formula text switches class every byte or two, so a branch per
+    // decision mispredicts often.
+    const unsigned char* s = (const unsigned char*)infix;
+    int n = 0;
+    int lastWord = 0;                    // The key ends in a name or number
+    int prevSpace = 0, prevWord = 0;     // Class of the previous input byte
+    int inNumber = 0, leading = 0;       // In a number token / still in its leading zeros
+    for (; *s != '\0'; s++) {
+        int cls = charClass[*s];
+        int isSpace = cls == CHAR_SPACE, isWord = cls >= CHAR_DIGIT;
+        int starts = isWord & !prevWord;                 // First byte of a name or number
+        inNumber = (cls == CHAR_DIGIT) & (starts | inNumber);
+        leading = inNumber & (starts | leading) & (*s == '0');
+        int drop = isSpace | (leading & (charClass[s[1]] == CHAR_DIGIT));
+        int space = starts & prevSpace & lastWord;      // Keep one space between two words
+        key[n] = ' ';
+        key[n + space] = (char)*s;
+        n += space + !drop;
+        lastWord = isSpace ? lastWord : isWord;
+        prevSpace = isSpace;
+        prevWord = isWord;
+    }
+    key[n] = '\0';
+    *hash = hashKey(key, n);
+    return n;
+}
+
+// Home slot from the top bits of the hash
+static inline uint32_t tableHome(const struct ExprCache* c, uint64_t hash) {
+    return homeSlot((uint32_t)(hash >> 32), c->shift);
+}
+
+// The two spelling slots for a raw hash: a set per table slot
+static inline struct Spelling* spellingSet(const struct ExprCache* c, uint64_t rawHash) {
+    return &c->spellings[2 * homeSlot((uint32_t)(rawHash >> 32), c->shift)];
+}
+
+// Slot of the set holding the raw spelling, NULL if neither does
+static struct Spelling* findSpelling(struct Spelling* set, uint64_t rawHash, const char* infix, size_t length) {
+    for (int k = 0; k < 2; k++) {
+        struct Spelling* spelling = &set[k];
+        if (spelling->hash == rawHash && spelling->text != NULL && (size_t)spelling->length == length &&
+            memcmp(spelling->text, infix, length) == 0)
+            return spelling;
+    }
+    return NULL;
+}
+
+// Entry a spelling led to, NULL if it has been evicted or refilled since
+static struct CacheEntry* spellingEntry(struct ExprCache* c, const struct Spelling* spelling) {
+    struct CacheEntry* entry = &c->entries[spelling->entry];
+    return entry->used && entry->generation == spelling->generation ? entry : NULL;
+}
+
+// Point a slot of the set at 'entry': the one already holding the spelling,
+// otherwise the first, whose spelling moves over the second (FIFO)
+static void rememberSpelling(struct ExprCache* c, struct Spelling* set, uint64_t rawHash,
+                             const char* infix, size_t length, const struct CacheEntry* entry) {
+    struct Spelling* spelling = &set[0];
+
+    if (length > SPELLING_MAX)
+        return;
+    if (set[1].hash == rawHash) {
+        spelling = &set[1];
+    } else if (set[0].hash != rawHash) {
+        struct Spelling oldest = set[1];     // Its text buffer is reused
+        set[1] = set[0];
+        set[0] = oldest;
+    }
+    if ((int)length + 1 > spelling->capacity) {
+        spelling->capacity = (int)length + 1;
+        spelling->text = (char*)checkedAlloc(realloc(spelling->text, spelling->capacity));
+    }
+    memcpy(spelling->text, infix, length + 1);
+    spelling->hash = rawHash;
+    spelling->length = (int)length;
+    spelling->entry = (int)(entry - c->entries);
+    spelling->generation = entry->generation;
+}
+
+// Table slot holding the key, or the empty slot where it would go
+static uint32_t findSlot(const struct ExprCache* c, uint64_t hash, const char* key, int length) {
+    uint32_t i = tableHome(c, hash);
+    for (;; i = (i + 1) & c->mask) {
+        int e = c->table[i];
+        if (e < 0)
+            return i;
+        const struct CacheEntry* entry = &c->entries[e];
+        if (entry->hash == hash && entry->keyLength == length && memcmp(entry->key, key, length) == 0)
+            return i;
+    }
+}
+
+// probeRemove() callbacks: 'table' is the cache
+static uint32_t entryHome(const void* table, uint32_t i) {
+    const struct ExprCache* c = (const struct ExprCache*)table;
+    return c->table[i] < 0 ? PROBE_EMPTY : tableHome(c, c->entries[c->table[i]].hash);
+}
+
+static void moveEntry(void* table, uint32_t to, uint32_t from) {
+    struct ExprCache* c = (struct ExprCache*)table;
+    c->table[to] = c->table[from];
+}
+
+// Empty a slot, shifting later probes back so lookups never hit a hole
+static void removeSlot(struct ExprCache* c, uint32_t hole) {
+    c->table[probeRemove(c, c->mask, hole, entryHome, moveEntry)] = -1;
+}
+
+// 1 if the entry under the hand is cold; otherwise age it, move past it and return 0
+static int handIsCold(struct ExprCache* c) {
+    for (;;) {
+        struct CacheEntry* entry = &c->entries[c->hand];
+        if (entry->used && entry->referenced == 0)
+            return 1;
+        c->hand = c->hand + 1 == c->highWater ? 0 : c->hand + 1;
+        if (entry->used) {
+            entry->referenced--;        // Another chance
+            return 0;
+        }
+    }
+}
+
+// Advance the hand to the first cold entry and drop it
+static void evictOne(struct ExprCache* c) {
+    while (!handIsCold(c))
+        ;
+    int index = c->hand;
+    struct CacheEntry* entry = &c->entries[index];
+
+    c->hand = c->hand + 1 == c->highWater ? 0 : c->hand + 1;
+    removeSlot(c, findSlot(c, entry->hash, entry->key, entry->keyLength));
+    c->bytes -= entry->bytes;
+    clearEntry(entry);
+    c->freeEntries[c->freeCount++] = index;
+    c->count--;
+    c->evictions++;
+}
+
+static void reserveScratch(struct ExprCache* c, int vars, int depth) {
+    if (vars > c->varCapacity) {
+        c->varCapacity = 2 * vars;
+        c->vars = (int*)checkedAlloc(realloc(c->vars, c->varCapacity * sizeof(int)));
+    }
+    if (depth > c->stackCapacity) {
+        c->stackCapacity = 2 * depth;
+        c->stack = (int*)checkedAlloc(realloc(c->stack, c->stackCapacity * sizeof(int)));
+    }
+}
+
+// Bytes a program is charged against the budget
+static size_t programBytes(const struct Program* p) {
+    return sizeof(struct Program) + p->length * (sizeof(unsigned char) + sizeof(int)) +
+           (p->varCount + 1) * BC_MAX_NAME;
+}
+
+// Compile the text in c->key into the scratch entry, which borrows c->key as its
+// key until it is kept; constant formulas are evaluated as well
+static void fillScratch(struct ExprCache* c, int length, uint64_t hash) {
+    struct CacheEntry* entry = &c->uncached;
+
+    entry->hash = hash;
+    entry->keyLength = length;
+    entry->key = c->key;
+    entry->errorPos = -1;
+    entry->bytes = sizeof(struct CacheEntry) + length + 1;
+
+    struct Program* p = compileExpression(entry->key, &entry->errorPos);
+    entry->program = p;
+    entry->optimized = 1;                // Unless there is a program worth optimizing
+    if (p == NULL)
+        return;
+    entry->bytes += programBytes(p);
+    if (p->varCount == 0) {
+        reserveScratch(c, 0, p->maxDepth);
+        entry->isConstant = 1;
+        entry->status = runProgram(p, NULL, c->stack, &entry->value);
+    } else {
+        entry->optimized = 0;
+    }
+}
+
+// Swap in the optimized program of an entry that keeps being hit; never grows the entry
+static void optimizeEntry(struct ExprCache* c, struct CacheEntry* entry) {
+    struct Program* p = optimizeProgram(entry->program);
+
+    entry->optimized = 1;
+    if (p == NULL || p->length >= entry->program->length) {
+        freeProgram(p);
+        return;
+    }
+    size_t saved = programBytes(entry->program) - programBytes(p);
+    freeProgram(entry->program);
+    entry->program = p;
+    entry->bytes -= saved;
+    c->bytes -= saved;
+}
+
+// Count a hit; an entry hit while its CLOCK count is still raised gets optimized
+static struct CacheEntry* hitEntry(struct ExprCache* c, struct CacheEntry* entry, int timed, double start) {
+    if (entry->referenced && !entry->optimized)
+        optimizeEntry(c, entry);
+    entry->referenced += entry->referenced < 3;
+    c->hits++;
+    if (timed) {
+        c->hitNs += nowNs() - start;
+        c->timedHits++;
+    }
+    return entry;
+}
+
+// Entry for 'infix', compiled on a miss. The pointer is valid until the next lookup.
+const struct CacheEntry* cacheLookup(struct ExprCache* c, const char* infix) {
+    int timed = c->lookups++ % LATENCY_SAMPLE == 0;
+    double start = timed ? nowNs() : 0;
+    size_t rawLength = strlen(infix);
+    uint64_t rawHash = hashKey(infix, rawLength);
+    struct Spelling* spellings = spellingSet(c, rawHash);
+    struct Spelling* known = findSpelling(spellings, rawHash, infix, rawLength);
+    struct CacheEntry* entry = known != NULL ? spellingEntry(c, known) : NULL;
+
+    if (entry != NULL)
+        return hitEntry(c, entry, timed, start);
+
+    // A spelling neither in its set nor seen within the filter's window is compiled as it is
+    uint64_t* seen = &c->seen[homeSlot((uint32_t)(rawHash >> 32), c->seenShift)];
+    int admit = known != NULL || *seen == rawHash;
+    *seen = admit ? 0 : rawHash;
+    c->misses += !admit;
+    clearScratch(c);
+    entry = &c->uncached;
+    if (!admit) {
+        memcpy(reserveKey(c, rawLength + 1), infix, rawLength + 1);
+        fillScratch(c, (int)rawLength, rawHash);
+    } else {
+        uint64_t hash;
+        int length = normalize(c, infix, rawLength, &hash);
+        uint32_t slot = findSlot(c, hash, c->key, length);
+
+        if (c->table[slot] >= 0) {
+            entry = &c->entries[c->table[slot]];
+            rememberSpelling(c, spellings, rawHash, infix, rawLength, entry);
+            return hitEntry(c, entry, timed, start);
+        }
+        c->misses++;
+        fillScratch(c, length, hash);
+        // Make room only out of cold entries
+        int room = entry->bytes <= c->maxBytes;
+        while (room && (c->count == c->capacity || c->bytes + entry->bytes > c->maxBytes))
+            if ((room = handIsCold(c)))
+                evictOne(c);
+        if (room) {
+            int index = c->freeEntries[--c->freeCount];
+            if (index >= c->highWater) {
+                // Widen the admission window along with the entries in use
+                uint32_t window = 4;
+                c->highWater = index + 1;
+                while (window < (uint32_t)c->highWater)
+                    window <<= 1;
+                c->seenShift = hashShift(window);
+            }
+            entry = &c->entries[index];
+            *entry = c->uncached;
+            entry->key = (char*)checkedAlloc(malloc(length + 1));
+            memcpy(entry->key, c->key, length + 1);
+            entry->used = 1;
+            entry->generation = ++c->generation;
+            memset(&c->uncached, 0, sizeof(struct CacheEntry));
+            // Evictions may have shifted the probe sequence, so look the slot up again
+            c->table[findSlot(c, hash, entry->key, length)] = index;
+            c->count++;
+            c->bytes += entry->bytes;
+            rememberSpelling(c, spellings, rawHash, infix, rawLength, entry);
+        }
+    }
+    if (timed) {
+        c->missNs += nowNs() - start;
+        c->timedMisses++;
+    }
+    return entry;
+}
+
+// Evaluate a looked-up entry with names[k] bound to values[k]; the value is stored in *result on EXPR_OK
+enum ExprStatus evaluateEntry(struct ExprCache* c, const struct CacheEntry* entry,
+                              const char* const* names, const int* values, int count, int* result) {
+    const struct Program* p = entry->program;
+
+    if (p == NULL)
+        return EXPR_SYNTAX_ERROR;
+    if (entry->isConstant) {
+        if (entry->status == EXPR_OK)
+            *result = entry->value;
+        return entry->status;
+    }
+    reserveScratch(c, p->varCount, p->maxDepth);
+    for (int v = 0; v < p->varCount; v++) {
+        int k = 0;
+        while (k < count && strcmp(names[k], p->varNames[v]) != 0)
+            k++;
+        if (k == count)
+            return EXPR_UNBOUND_VARIABLE;
+        c->vars[v] = values[k];
+    }
+    return runProgram(p, c->vars, c->stack, result);
+}
+
+// Look 'infix' up and evaluate it: the read-through path callers use
+enum ExprStatus cacheEvaluate(struct ExprCache* c, const char* infix,
+                              const char* const* names, const int* values, int count, int* result) {
+    return evaluateEntry(c, cacheLookup(c, infix), names, values, count, result);
+}
+
+void printStats(const struct ExprCache* c) {
+    long long lookups = c->hits + c->misses;
+    printf("Hits: %lld, misses: %lld, evictions: %lld, hit ratio: %.1f%%\n",
+           c->hits, c->misses, c->evictions,
+           lookups ? 100.0 * c->hits / lookups : 0.0);
+}
+
+// Lookup latency over the sampled lookups
+void printLatency(const struct ExprCache* c) {
+    printf("Lookup latency: hit %.1f ns, miss %.1f ns (%lld + %lld timed), %d entries, %zu bytes\n",
+           c->timedHits ? c->hitNs / c->timedHits : 0.0,
+           c->timedMisses ? c->missNs / c->timedMisses : 0.0,
+           c->timedHits, c->timedMisses, c->count, c->bytes);
+}
+
+// Compile and run on every call: what the callers do without the cache
+static enum ExprStatus evaluateUncached(const char* infix, const char* const* names, const int* values,
+                                        int count, int* result) {
+    int vars[8], stack[64], errorPos;
+    struct Program* p = compileExpression(infix, &errorPos);
+    enum ExprStatus status = EXPR_OK;
+
+    if (p == NULL)
+        return EXPR_SYNTAX_ERROR;
+    for (int v = 0; v < p->varCount && status == EXPR_OK; v++) {
+        int k = 0;
+        while (k < count && strcmp(names[k], p->varNames[v]) != 0)
+            k++;
+        if (k == count)
+            status = EXPR_UNBOUND_VARIABLE;
+        else
+            vars[v] = values[k];
+    }
+    if (status == EXPR_OK)
+        status = runProgram(p, vars, stack, result);
+    freeProgram(p);
+    return status;
+}
+
+static unsigned int nextRandom(unsigned int* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+// Append a random formula to 'out'. The same seed always gives the same
+// formula; 'style' only changes the spelling (0 tight, 1 spaced, 2 spaced
+// with leading zeros). Divisors are non-zero constants.
+static int writeFormula(char* out, unsigned int* seed, int depth, int constOnly, int style, int divisor) {
+    static const char* names[] = {"x", "y", "rate"};
+    const char* pad = style ? " " : "";
+    unsigned int r = nextRandom(seed);
+
+    if (divisor)
+        return sprintf(out, "%s%u", style == 2 ? "0" : "", 1 + r % 9);
+    if (depth == 0 || r % 4 == 0) {
+        if (!constOnly && r % 3 == 0)
+            return sprintf(out, "%s", names[r / 3 % 3]);
+        return sprintf(out, "%s%u", style == 2 ? "00" : "", r % 1000);
+    }
+    char op = "+-*/+-*"[r / 4 % 7];
+    int len = sprintf(out, "(%s", pad);
+    len += writeFormula(out + len, seed, depth - 1, constOnly, style, 0);
+    len += sprintf(out + len, "%s%c%s", pad, op, pad);
+    len += writeFormula(out + len, seed, depth - 1, constOnly, style, op == '/');
+    len += sprintf(out + len, "%s)", pad);
+    return len;
+}
+
+// Ranks drawn from a Zipf(s) distribution over 'keys' formulas, as in LRUCache.c
+static void zipfTrace(int* trace, int length, int keys, double s, unsigned int seed) {
+    double* cdf = (double*)checkedAlloc(malloc(keys * sizeof(double)));
+    double sum = 0;
+    for (int k = 0; k < keys; k++) {
+        sum += 1.0 / pow(k + 1, s);
+        cdf[k] = sum;
+    }
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        double u = (seed >> 8) / 16777216.0 * sum;
+        int lo = 0, hi = keys - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        trace[i] = lo;
+    }
+    free(cdf);
+}
+
+static const char* const bindNames[] = {"x", "y", "rate"};
+static const int bindValues[] = {7, -3, 12};
+
+// One benchmark setting: capacity 0 means no cache
+struct BenchRow {
+    int capacity;
+    size_t maxBytes;
+    double ns;                  // Fastest run so far, per formula
+    long long sum;
+    long errors;
+    struct ExprCache* c;        // Cache of the last run, for the counters
+};
+
+// Evaluate every formula of the trace on a fresh cache
+void benchmark(struct BenchRow* row, char* const* spellings, const int* trace, int length) {
+    freeCache(row->c);
+    struct ExprCache* c = row->capacity ? createCache(row->capacity, row->maxBytes) : NULL;
+    long long sum = 0;
+    long errors = 0;
+    int result;
+
+    double start = nowNs();
+    for (int i = 0; i < length; i++) {
+        // Each formula comes in three spellings, picked by position in the trace
+        const char* infix = spellings[3 * trace[i] + i % 3];
+        enum ExprStatus status = c ? cacheEvaluate(c, infix, bindNames, bindValues, 3, &result)
+                                   : evaluateUncached(infix, bindNames, bindValues, 3, &result);
+        if (status == EXPR_OK)
+            sum += result;
+        else
+            errors++;
+    }
+    double ns = (nowNs() - start) / length;
+    if (row->ns == 0 || ns < row->ns)
+        row->ns = ns;
+    row->sum = sum;
+    row->errors = errors;
+    row->c = c;
+}
+
+void printRow(struct BenchRow* row) {
+    if (row->c == NULL) {
+        printf("  no cache                   %6.1f ns/formula  (sum %lld, %ld errors)\n",
+               row->ns, row->sum, row->errors);
+        return;
+    }
+    printf("  %5d entries, %7zu bytes %6.1f ns/formula  (sum %lld, %ld errors)\n",
+           row->capacity, row->maxBytes, row->ns, row->sum, row->errors);
+    printf("    ");
+    printStats(row->c);
+    printf("    ");
+    printLatency(row->c);
+    freeCache(row->c);
+    row->c = NULL;
+}
+
+void demo(struct ExprCache* c, const char* infix) {
+    long long hits = c->hits;
+    const struct CacheEntry* entry = cacheLookup(c, infix);
+    int result;
+    enum ExprStatus status = evaluateEntry(c, entry, bindNames, bindValues, 3, &result);
+
+    int kept = entry != &c->uncached;
+
+    printf("%-16s %-10s key \"%s\"", infix, c->hits > hits ? "hit" : kept ? "miss, kept" : "miss", entry->key);
+    if (status == EXPR_OK)
+        printf(" = %d", result);
+    else if (status == EXPR_SYNTAX_ERROR)
+        printf(" syntax error at key position %d", entry->errorPos);
+    else if (status == EXPR_DIV_ZERO)
+        printf(" division by zero");
+    else
+        printf(" unbound variable");
+    printf("%s\n", entry->isConstant && kept ? "  (constant, value cached)" : "");
+}
+
+// Driver Code
+int main() {
+    struct ExprCache* c = createCache(4, 1 << 20);
+    const char* examples[] = {
+        "(x + 2) * y",
+        "(x + 2) * y",
+        "(x + 2) * y",
+        "( x+2 )*y",
+        "( x+2 )*y",
+        "(x+002) * y",
+        "2 ^ 10 - 24",
+        "2 ^ 10 - 24",
+        "  2^10-0024",
+        "  2^10-0024",
+        "10 / (5 - 5)",
+        "10 / (5 - 5)",
+        "(a + ) 1",
+        "(a + ) 1",
+        "rate * 100 / 12",
+        "x * x + y",
+        "2 ^ 10 - 24",
+    };
+    printf("x = 7, y = -3, rate = 12; cache of 4 formulas:\n");
+    for (int k = 0; k < 17; k++)
+        demo(c, examples[k]);
+    printStats(c);
+    freeCache(c);
+
+    // 2000 distinct formulas, about half of them constant-only, three spellings each
+    const int formulas = 2000, length = 2000000;
+    char** spellings = (char**)checkedAlloc(malloc(3 * formulas * sizeof(char*)));
+    for (int f = 0; f < formulas; f++)
+        for (int style = 0; style < 3; style++) {
+            unsigned int seed = 7919u * f + 1;
+            spellings[3 * f + style] = (char*)checkedAlloc(malloc(512));
+            writeFormula(spellings[3 * f + style], &seed, 4, f % 2, style, 0);
+        }
+    printf("\nFor example: %s\n             %s\n             %s\n",
+           spellings[6], spellings[7], spellings[8]);
+
+    int* trace = (int*)checkedAlloc(malloc(length * sizeof(int)));
+    zipfTrace(trace, length, formulas, 1.0, 2024);
+    const int capacities[] = {0, 64, 256, 1024, 4096, 4096};
+    const size_t budgets[] = {0, 1 << 24, 1 << 24, 1 << 24, 1 << 24, 1 << 16};
+    const int rowCount = sizeof(capacities) / sizeof(capacities[0]), rounds = 3;
+    struct BenchRow rows[sizeof(capacities) / sizeof(capacities[0])];
+    for (int k = 0; k < rowCount; k++)
+        rows[k] = (struct BenchRow){capacities[k], budgets[k], 0, 0, 0, NULL};
+    // Every round runs every setting once, so a slow spell of the machine
+    // costs all of them a round; each row keeps its fastest
+    for (int r = 0; r < rounds; r++)
+        for (int k = 0; k < rowCount; k++)
+            benchmark(&rows[k], spellings, trace, length);
+    printf("\n%d formulas, Zipf s=1.00 over %d distinct ones, best of %d rounds:\n", length, formulas, rounds);
+    for (int k = 0; k < rowCount; k++)
+        printRow(&rows[k]);
+
+    for (int i = 0; i < 3 * formulas; i++)
+        free(spellings[i]);
+    free(spellings);
+    free(trace);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    x = 7, y = -3, rate = 12; cache of 4 formulas:
+    (x + 2) * y      miss       key "(x + 2) * y" = -27
+    (x + 2) * y      miss, kept key "(x+2)*y" = -27
+    (x + 2) * y      hit        key "(x+2)*y" = -27
+    ( x+2 )*y        miss       key "( x+2 )*y" = -27
+    ( x+2 )*y        hit        key "(x+2)*y" = -27
+    (x+002) * y      miss       key "(x+002) * y" = -27
+    2 ^ 10 - 24      miss       key "2 ^ 10 - 24" = 1000
+    2 ^ 10 - 24      miss, kept key "2^10-24" = 1000  (constant, value cached)
+      2^10-0024      miss       key "  2^10-0024" = 1000
+      2^10-0024      hit        key "2^10-24" = 1000  (constant, value cached)
+    10 / (5 - 5)     miss       key "10 / (5 - 5)" division by zero
+    10 / (5 - 5)     miss, kept key "10/(5-5)" division by zero  (constant, value cached)
+    (a + ) 1         miss       key "(a + ) 1" syntax error at key position 5
+    (a + ) 1         miss, kept key "(a+)1" syntax error at key position 3
+    rate * 100 / 12  miss       key "rate * 100 / 12" = 100
+    x * x + y        miss       key "x * x + y" = 46
+    2 ^ 10 - 24      hit        key "2^10-24" = 1000  (constant, value cached)
+    Hits: 4, misses: 13, evictions: 0, hit ratio: 23.5%
+
+    For example: (x+(x/7))
+                 ( x + ( x / 7 ) )
+                 ( x + ( x / 07 ) )
+
+    2000000 formulas, Zipf s=1.00 over 2000 distinct ones, best of 3 rounds:
+      no cache                    606.4 ns/formula  (sum -24147236335387, 0 errors)
+         64 entries, 16777216 bytes  467.3 ns/formula  (sum -24147236335387, 0 errors)
+        Hits: 1119907, misses: 880093, evictions: 41, hit ratio: 56.0%
+        Lookup latency: hit 155.8 ns, miss 874.3 ns (17779 + 13471 timed), 64 entries, 16817 bytes
+        256 entries, 16777216 bytes  336.3 ns/formula  (sum -24147236335387, 0 errors)
+        Hits: 1461924, misses: 538076, evictions: 104, hit ratio: 73.1%
+        Lookup latency: hit 180.2 ns, miss 1143.7 ns (22932 + 8318 timed), 256 entries, 63704 bytes
+       1024 entries, 16777216 bytes  285.1 ns/formula  (sum -24147236335387, 0 errors)
+        Hits: 1802174, misses: 197826, evictions: 61, hit ratio: 90.1%
+        Lookup latency: hit 261.6 ns, miss 1427.1 ns (28215 + 3035 timed), 1024 entries, 266728 bytes
+       4096 entries, 16777216 bytes  201.1 ns/formula  (sum -24147236335387, 0 errors)
+        Hits: 1967978, misses: 32022, evictions: 0, hit ratio: 98.4%
+        Lookup latency: hit 229.7 ns, miss 1511.0 ns (30764 + 486 timed), 1739 entries, 464858 bytes
+       4096 entries,   65536 bytes  391.6 ns/formula  (sum -24147236335387, 0 errors)
+        Hits: 1534631, misses: 465369, evictions: 353, hit ratio: 76.7%
+        Lookup latency: hit 183.4 ns, miss 1334.5 ns (24084 + 7166 timed), 281 entries, 65443 bytes
+*/
@@ -0,0 +1,633 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>     // for uint32_t
+#include <string.h>     // for strcmp(), memset()
+#include <ctype.h>      // for isalpha(), isalnum()
+#include <limits.h>     // for INT_MAX
+#include <time.h>       // for clock_gettime()
+#include "Bytecode.h"   // for compileExpression() and runProgram()
+#include "Optimizer.h"  // for dagHash() and foldConstant()
+#include "../LinkedList/OpenAddressing.h"  // for homeSlot() and hashShift()
+
+/*
+    Incremental evaluation of many live formulas, spreadsheet style.
+
+    Every formula is compiled to postfix bytecode, and the bytecode is
+    replayed on a stack of node numbers instead of values, as
+    optimizeProgram() does. The nodes of all formulas go into one DAG and
+    are hash-consed across formulas, so "price * qty" written in fifty
+    formulas is one node with fifty parents. The optimizer's rewrites are
+    not applied: a variable here may be a formula that divides by zero,
+    and x*0 or x-x must still fail then. A name that is not a
+    formula is an input; a formula may use any formula defined before it,
+    which keeps the graph acyclic.
+
+    Each node caches its value. setInput() changes an input node and
+    queues its parents; recompute() then takes queued nodes in order of
+    level (leaves are level 0, an operator is one above its deeper child),
+    so a node is evaluated only after everything below it is final. When
+    a node comes out unchanged its parents are not queued, so an update
+    costs time proportional to the part of the graph that really changed,
+    not to the number of formulas.
+
+    Division by zero marks the node failed; failure propagates upward like
+    a value and clears again once the divisor changes.
+*/
+
+struct EngineNode {
+    unsigned char op;           // enum OpCode; OP_VAR nodes are inputs
+    unsigned char failed;       // Divides by zero somewhere below
+    unsigned char queued;
+    int operand;                // Constant value, or name index of an input
+    int left, right;            // Child nodes, -1 if none
+    int level;
+    int value;
+    int nextQueued;             // Next node queued at the same level
+    int* parents;
+    int parentCount;
+    int parentCapacity;
+};
+
+struct Engine {
+    struct EngineNode* nodes;
+    int nodeCount;
+    int nodeCapacity;
+    int* table;                 // Open addressing over node numbers, -1 empty
+    uint32_t mask;
+    int shift;                  // 32 - log2(table size)
+    char (*names)[BC_MAX_NAME]; // Inputs and formulas
+    int* nameNode;              // Input node, or root node of the formula
+    unsigned char* isFormula;
+    int nameCount;
+    int nameCapacity;
+    int* nameTable;             // Open addressing over name indices, -1 empty
+    uint32_t nameMask;
+    int nameShift;
+    int* queue;                 // First queued node per level, -1 if none
+    int levels;                 // Entries in 'queue'
+    int lowestQueued;
+    int highestQueued;
+    long long recomputed;       // Nodes evaluated by recompute() so far
+};
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void* checkedAlloc(void* ptr) {
+    if (ptr == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+static uint32_t hashName(const char* name) {
+    uint32_t h = 2166136261u;                 // FNV-1a
+    while (*name)
+        h = (h ^ (unsigned char)*name++) * 16777619u;
+    return h;
+}
+
+struct Engine* createEngine(void) {
+    struct Engine* e = (struct Engine*)checkedAlloc(calloc(1, sizeof(struct Engine)));
+    e->mask = 63;
+    e->shift = hashShift(e->mask + 1);
+    e->table = (int*)checkedAlloc(malloc((e->mask + 1) * sizeof(int)));
+    memset(e->table, 0xff, (e->mask + 1) * sizeof(int));
+    e->nameMask = 63;
+    e->nameShift = hashShift(e->nameMask + 1);
+    e->nameTable = (int*)checkedAlloc(malloc((e->nameMask + 1) * sizeof(int)));
+    memset(e->nameTable, 0xff, (e->nameMask + 1) * sizeof(int));
+    e->lowestQueued = INT_MAX;
+    e->highestQueued = -1;
+    return e;
+}
+
+void freeEngine(struct Engine* e) {
+    for (int n = 0; n < e->nodeCount; n++)
+        free(e->nodes[n].parents);
+    free(e->nodes);
+    free(e->table);
+    free(e->names);
+    free(e->nameNode);
+    free(e->isFormula);
+    free(e->nameTable);
+    free(e->queue);
+    free(e);
+}
+
+// Slot of 'name' in the name table, or the empty slot where it would go
+static uint32_t findName(const struct Engine* e, const char* name) {
+    uint32_t i = homeSlot(hashName(name), e->nameShift);
+    while (e->nameTable[i] >= 0 && strcmp(e->names[e->nameTable[i]], name) != 0)
+        i = (i + 1) & e->nameMask;
+    return i;
+}
+
+// A name the compiler would accept: letter or '_', then letters, digits or '_'
+static int validName(const char* name) {
+    int len = 0;
+    if (!isalpha((unsigned char)name[0]) && name[0] != '_')
+        return 0;
+    while (isalnum((unsigned char)name[len]) || name[len] == '_')
+        len++;
+    return name[len] == '\0' && len < BC_MAX_NAME;
+}
+
+// Index of 'name', -1 if it was never used
+static int lookupName(const struct Engine* e, const char* name) {
+    return e->nameTable[findName(e, name)];
+}
+
+// Register a new name; the caller sets nameNode and isFormula
+static int addName(struct Engine* e, const char* name) {
+    if ((e->nameCount + 1) * 2 > (int)e->nameMask + 1) {
+        free(e->nameTable);
+        e->nameMask = e->nameMask * 2 + 1;
+        e->nameShift--;
+        e->nameTable = (int*)checkedAlloc(malloc((e->nameMask + 1) * sizeof(int)));
+        memset(e->nameTable, 0xff, (e->nameMask + 1) * sizeof(int));
+        for (int k = 0; k < e->nameCount; k++)
+            e->nameTable[findName(e, e->names[k])] = k;
+    }
+    if (e->nameCount == e->nameCapacity) {
+        e->nameCapacity = e->nameCapacity ? 2 * e->nameCapacity : 64;
+        e->names = (char (*)[BC_MAX_NAME])checkedAlloc(realloc(e->names, e->nameCapacity * BC_MAX_NAME));
+        e->nameNode = (int*)checkedAlloc(realloc(e->nameNode, e->nameCapacity * sizeof(int)));
+        e->isFormula = (unsigned char*)checkedAlloc(realloc(e->isFormula, e->nameCapacity));
+    }
+    strcpy(e->names[e->nameCount], name);
+    e->nameTable[findName(e, name)] = e->nameCount;
+    return e->nameCount++;
+}
+
+// Evaluate one node from its children; returns 1 if its value or failure changed
+static int computeNode(struct Engine* e, struct EngineNode* node) {
+    const struct EngineNode* N = e->nodes;
+    int value = node->value, failed = 0;
+
+    if (node->op == OP_CONST || node->op == OP_VAR)
+        return 0;
+    if (N[node->left].failed || (node->right >= 0 && N[node->right].failed))
+        failed = 1;
+    else if (node->op == OP_NEG)
+        value = (int)(0u - (unsigned int)N[node->left].value);
+    else if (!foldConstant(node->op, N[node->left].value, N[node->right].value, &value))
+        failed = 1;                           // Division by zero
+    if (failed)
+        value = 0;
+    if (value == node->value && failed == node->failed)
+        return 0;
+    node->value = value;
+    node->failed = (unsigned char)failed;
+    return 1;
+}
+
+static void addParent(struct EngineNode* child, int parent) {
+    if (child->parentCount == child->parentCapacity) {
+        child->parentCapacity = child->parentCapacity ? 2 * child->parentCapacity : 2;
+        child->parents = (int*)checkedAlloc(realloc(child->parents, child->parentCapacity * sizeof(int)));
+    }
+    child->parents[child->parentCount++] = parent;
+}
+
+// Node (op, operand, left, right), created and evaluated only if no identical node exists
+static int engineNode(struct Engine* e, int op, int operand, int left, int right) {
+    uint32_t i = homeSlot(dagHash(op, operand, left, right), e->shift);
+    for (; e->table[i] >= 0; i = (i + 1) & e->mask) {
+        const struct EngineNode* node = &e->nodes[e->table[i]];
+        if (node->op == op && node->operand == operand && node->left == left && node->right == right)
+            return e->table[i];
+    }
+
+    if (e->nodeCount == e->nodeCapacity) {
+        e->nodeCapacity = e->nodeCapacity ? 2 * e->nodeCapacity : 64;
+        e->nodes = (struct EngineNode*)checkedAlloc(realloc(e->nodes, e->nodeCapacity * sizeof(struct EngineNode)));
+    }
+    int n = e->nodeCount++;
+    struct EngineNode* node = &e->nodes[n];
+    memset(node, 0, sizeof(struct EngineNode));
+    node->op = (unsigned char)op;
+    node->operand = operand;
+    node->left = left;
+    node->right = right;
+    node->value = op == OP_CONST ? operand : 0;
+    if (left >= 0) {
+        node->level = e->nodes[left].level + 1;
+        addParent(&e->nodes[left], n);
+    }
+    if (right >= 0 && right != left) {
+        if (e->nodes[right].level + 1 > node->level)
+            node->level = e->nodes[right].level + 1;
+        addParent(&e->nodes[right], n);
+    }
+    computeNode(e, node);
+    e->table[i] = n;
+
+    // Keep the table at most half full
+    if (e->nodeCount * 2 > (int)e->mask + 1) {
+        free(e->table);
+        e->mask = e->mask * 2 + 1;
+        e->shift--;
+        e->table = (int*)checkedAlloc(malloc((e->mask + 1) * sizeof(int)));
+        memset(e->table, 0xff, (e->mask + 1) * sizeof(int));
+        for (int k = 0; k < e->nodeCount; k++) {
+            const struct EngineNode* m = &e->nodes[k];
+            uint32_t j = homeSlot(dagHash(m->op, m->operand, m->left, m->right), e->shift);
+            while (e->table[j] >= 0)
+                j = (j + 1) & e->mask;
+            e->table[j] = k;
+        }
+    }
+    return n;
+}
+
+/*
+    Define formula 'name' as 'infix'. Returns 1 on success, 0 on a syntax
+    error (offset in *errorPos), or with *errorPos -1 when 'name' is not an
+    identifier of at most BC_MAX_NAME - 1 characters or is already an input
+    or a formula. Inputs it mentions for the first time start
+    at 0; call setInput() and recompute() to give them values.
+*/
+int defineFormula(struct Engine* e, const char* name, const char* infix, int* errorPos) {
+    *errorPos = -1;
+    if (!validName(name) || lookupName(e, name) >= 0)
+        return 0;
+    struct Program* p = compileExpression(infix, errorPos);
+    if (p == NULL)
+        return 0;
+    // A name used by its own formula would be a cycle
+    if (findVariable(p, name) >= 0) {
+        freeProgram(p);
+        return 0;
+    }
+
+    // Replay the postfix program on node numbers
+    int* stack = (int*)checkedAlloc(malloc(p->maxDepth * sizeof(int)));
+    int top = -1;
+    for (int pc = 0; pc < p->length; pc++) {
+        int op = p->ops[pc], operand = p->operands[pc];
+        if (op == OP_CONST) {
+            stack[++top] = engineNode(e, OP_CONST, operand, -1, -1);
+        } else if (op == OP_VAR) {
+            int k = lookupName(e, p->varNames[operand]);
+            if (k < 0) {
+                k = addName(e, p->varNames[operand]);
+                e->isFormula[k] = 0;
+                e->nameNode[k] = engineNode(e, OP_VAR, k, -1, -1);
+            }
+            stack[++top] = e->nameNode[k];
+        } else if (op == OP_NEG) {
+            stack[top] = engineNode(e, OP_NEG, 0, stack[top], -1);
+        } else {
+            top--;
+            stack[top] = engineNode(e, op, 0, stack[top], stack[top + 1]);
+        }
+    }
+    int k = addName(e, name);
+    e->isFormula[k] = 1;
+    e->nameNode[k] = stack[top];
+    free(stack);
+    freeProgram(p);
+    return 1;
+}
+
+static void queueNode(struct Engine* e, int n) {
+    struct EngineNode* node = &e->nodes[n];
+    if (node->queued)
+        return;
+    if (node->level >= e->levels) {
+        int levels = 2 * node->level + 2;
+        e->queue = (int*)checkedAlloc(realloc(e->queue, levels * sizeof(int)));
+        memset(e->queue + e->levels, 0xff, (levels - e->levels) * sizeof(int));
+        e->levels = levels;
+    }
+    node->queued = 1;
+    node->nextQueued = e->queue[node->level];
+    e->queue[node->level] = n;
+    if (node->level < e->lowestQueued) e->lowestQueued = node->level;
+    if (node->level > e->highestQueued) e->highestQueued = node->level;
+}
+
+static void queueParents(struct Engine* e, int n) {
+    const struct EngineNode* node = &e->nodes[n];
+    for (int k = 0; k < node->parentCount; k++)
+        queueNode(e, node->parents[k]);
+}
+
+// Change input 'name'; returns 0 if it is not an input. Takes effect on recompute().
+int setInput(struct Engine* e, const char* name, int value) {
+    int k = lookupName(e, name);
+    if (k < 0 || e->isFormula[k])
+        return 0;
+    struct EngineNode* node = &e->nodes[e->nameNode[k]];
+    if (node->value != value) {
+        node->value = value;
+        queueParents(e, e->nameNode[k]);
+    }
+    return 1;
+}
+
+// Bring every node up to date after setInput() calls; returns the nodes evaluated
+int recompute(struct Engine* e) {
+    int count = 0;
+    for (int level = e->lowestQueued; level <= e->highestQueued; level++) {
+        while (e->queue[level] >= 0) {
+            int n = e->queue[level];
+            struct EngineNode* node = &e->nodes[n];
+            e->queue[level] = node->nextQueued;
+            node->queued = 0;
+            count++;
+            if (computeNode(e, node))
+                queueParents(e, n);       // Parents are on higher levels, still ahead
+        }
+    }
+    e->lowestQueued = INT_MAX;
+    e->highestQueued = -1;
+    e->recomputed += count;
+    return count;
+}
+
+// Current value of formula or input 'name'
+enum ExprStatus getValue(const struct Engine* e, const char* name, int* value) {
+    int k = lookupName(e, name);
+    if (k < 0)
+        return EXPR_UNBOUND_VARIABLE;
+    const struct EngineNode* node = &e->nodes[e->nameNode[k]];
+    if (node->failed)
+        return EXPR_DIV_ZERO;
+    *value = node->value;
+    return EXPR_OK;
+}
+
+void printValues(const struct Engine* e, const char* const* names, int count) {
+    for (int i = 0; i < count; i++) {
+        int value;
+        if (getValue(e, names[i], &value) == EXPR_OK)
+            printf("  %s = %d", names[i], value);
+        else
+            printf("  %s = #DIV/0", names[i]);
+    }
+    printf("\n");
+}
+
+/*
+    The baseline: every formula's bytecode is run again on each update, in
+    definition order so the formulas it uses are already current. Variable
+    i of formula f reads values[varIds[f][i]], an input or an earlier formula.
+*/
+struct FullEvaluator {
+    struct Program** programs;
+    int** varIds;
+    int* formulaId;             // Name index each formula writes
+    int count;
+    int* values;                // Per name index
+    unsigned char* failed;
+    int* vars;
+    int* stack;
+};
+
+static void evaluateAll(struct FullEvaluator* f) {
+    for (int i = 0; i < f->count; i++) {
+        const struct Program* p = f->programs[i];
+        int failed = 0, value = 0;
+        for (int v = 0; v < p->varCount; v++) {
+            failed |= f->failed[f->varIds[i][v]];
+            f->vars[v] = f->values[f->varIds[i][v]];
+        }
+        if (!failed && runProgram(p, f->vars, f->stack, &value) != EXPR_OK)
+            failed = 1;
+        f->values[f->formulaId[i]] = failed ? 0 : value;
+        f->failed[f->formulaId[i]] = (unsigned char)failed;
+    }
+}
+
+static unsigned int nextRandom(unsigned int* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+// Random formula over inputs in0.. (skewed toward low numbers) and earlier formulas
+static int writeFormula(char* out, unsigned int* seed, int depth, int inputs, int formula) {
+    unsigned int r = nextRandom(seed);
+    if (depth == 0 || r % 4 == 0) {
+        if (r % 3 == 0)
+            return sprintf(out, "%u", 1 + r / 3 % 50);
+        if (r % 3 == 1 && formula > 0)
+            return sprintf(out, "f%u", formula - 1 - r / 3 % (formula < 200 ? formula : 200));
+        unsigned int u = r / 3 % 1000;
+        return sprintf(out, "in%u", u * u / 1000 * inputs / 1000);
+    }
+    char op = "+-*+-*/"[r / 4 % 7];
+    int len = sprintf(out, "(");
+    len += writeFormula(out + len, seed, depth - 1, inputs, formula);
+    len += sprintf(out + len, " %c ", op);
+    len += writeFormula(out + len, seed, depth - 1, inputs, formula);
+    return len + sprintf(out + len, ")");
+}
+
+// Set input 'input' on both sides; the engine catches up on recompute()
+static void changeInput(struct Engine* e, struct FullEvaluator* f, int input, int value) {
+    char name[BC_MAX_NAME];
+    sprintf(name, "in%d", input);
+    setInput(e, name, value);
+    f->values[lookupName(e, name)] = value;
+}
+
+// Change inputs one at a time: incremental engine against re-running every formula
+void benchmark(struct Engine* e, struct FullEvaluator* f, int inputs, int fullUpdates, int updates) {
+    unsigned int seed = 99;
+    const char* labels[] = {"rare input", "random input", "hot input"};
+    int rare = 0, hot = 0;
+
+    // Inputs with the fewest (but some) and the most parent nodes
+    for (int i = 0; i < inputs; i++) {
+        int parents = e->nodes[e->nameNode[i]].parentCount;
+        if (parents > 0 && (e->nodes[e->nameNode[rare]].parentCount == 0 ||
+                            parents < e->nodes[e->nameNode[rare]].parentCount))
+            rare = i;
+        if (parents > e->nodes[e->nameNode[hot]].parentCount)
+            hot = i;
+    }
+    for (int kind = 0; kind < 3; kind++) {
+        long long before = e->recomputed;
+        double start = nowNs();
+        for (int u = 0; u < updates; u++) {
+            int input = kind == 0 ? rare : kind == 1 ? (int)(nextRandom(&seed) % inputs) : hot;
+            changeInput(e, f, input, (int)(nextRandom(&seed) % 100) - 20);
+            recompute(e);
+        }
+        double ns = (nowNs() - start) / updates;
+        printf("  %-12s incremental %10.1f ns, %8.1f nodes per update\n",
+               labels[kind], ns, (double)(e->recomputed - before) / updates);
+    }
+
+    // The full pass costs the same whatever changed
+    double start = nowNs();
+    for (int u = 0; u < fullUpdates; u++) {
+        changeInput(e, f, (int)(nextRandom(&seed) % inputs), (int)(nextRandom(&seed) % 100) - 20);
+        evaluateAll(f);
+    }
+    double ns = (nowNs() - start) / fullUpdates;
+    recompute(e);
+    printf("  %-12s full pass   %10.1f ns, %8d formulas per update\n", "any input", ns, f->count);
+}
+
+// Driver Code
+int main() {
+    struct Engine* e = createEngine();
+    int errorPos;
+    const char* sheet[][2] = {
+        {"subtotal", "price * qty"},
+        {"tax",      "subtotal * rate / 100"},
+        {"total",    "subtotal + tax - discount"},
+        {"perUnit",  "total / qty"},
+        {"margin",   "(price - cost) * qty - discount"},
+    };
+    const char* shown[] = {"subtotal", "tax", "total", "perUnit", "margin"};
+
+    for (int i = 0; i < 5; i++)
+        if (!defineFormula(e, sheet[i][0], sheet[i][1], &errorPos))
+            printf("Cannot define %s\n", sheet[i][0]);
+    printf("Formulas: %d nodes for 5 formulas\n", e->nodeCount);
+    setInput(e, "price", 25);
+    setInput(e, "qty", 4);
+    setInput(e, "rate", 8);
+    setInput(e, "cost", 15);
+    printf("All inputs set: %d nodes evaluated\n", recompute(e));
+    printValues(e, shown, 5);
+
+    setInput(e, "rate", 10);
+    printf("rate = 10: %d nodes evaluated\n", recompute(e));
+    printValues(e, shown, 5);
+    setInput(e, "discount", 5);
+    printf("discount = 5: %d nodes evaluated\n", recompute(e));
+    printValues(e, shown, 5);
+    setInput(e, "qty", 0);
+    printf("qty = 0: %d nodes evaluated\n", recompute(e));
+    printValues(e, shown, 5);
+    setInput(e, "qty", 4);
+    printf("qty = 4: %d nodes evaluated\n", recompute(e));
+    printValues(e, shown, 5);
+    setInput(e, "cost", 15);
+    printf("cost = 15 (unchanged): %d nodes evaluated\n", recompute(e));
+    if (!defineFormula(e, "loop", "loop + 1", &errorPos))
+        printf("loop = loop + 1 rejected\n");
+    if (!defineFormula(e, "a_name_longer_than_the_32_byte_slot", "price + 1", &errorPos))
+        printf("a_name_longer_than_the_32_byte_slot rejected (errorPos %d)\n", errorPos);
+    if (!defineFormula(e, "net-price", "price + 1", &errorPos))
+        printf("net-price rejected (errorPos %d)\n", errorPos);
+    freeEngine(e);
+
+    // A large sheet: formulas over 1000 inputs and the 200 formulas before them
+    const int inputs = 1000, formulas = 20000;
+    struct FullEvaluator full = {0};
+    char text[512], name[BC_MAX_NAME];
+    e = createEngine();
+    full.programs = (struct Program**)checkedAlloc(malloc(formulas * sizeof(struct Program*)));
+    full.varIds = (int**)checkedAlloc(malloc(formulas * sizeof(int*)));
+    full.formulaId = (int*)checkedAlloc(malloc(formulas * sizeof(int)));
+    int maxDepth = 0, maxVars = 0;
+    for (int i = 0; i < inputs; i++) {
+        sprintf(name, "in%d", i);
+        int k = addName(e, name);
+        e->isFormula[k] = 0;
+        e->nameNode[k] = engineNode(e, OP_VAR, k, -1, -1);
+    }
+    for (int i = 0; i < formulas; i++) {
+        unsigned int seed = 7919u * i + 3;
+        writeFormula(text, &seed, 3, inputs, i);
+        sprintf(name, "f%d", i);
+        if (!defineFormula(e, name, text, &errorPos)) {
+            printf("Cannot define %s = %s\n", name, text);
+            return 1;
+        }
+        struct Program* p = compileExpression(text, &errorPos);
+        full.programs[i] = p;
+        full.varIds[i] = (int*)checkedAlloc(malloc((p->varCount + 1) * sizeof(int)));
+        for (int v = 0; v < p->varCount; v++)
+            full.varIds[i][v] = lookupName(e, p->varNames[v]);
+        full.formulaId[i] = lookupName(e, name);
+        if (p->maxDepth > maxDepth) maxDepth = p->maxDepth;
+        if (p->varCount > maxVars) maxVars = p->varCount;
+    }
+    full.count = formulas;
+    full.values = (int*)checkedAlloc(calloc(e->nameCount, sizeof(int)));
+    full.failed = (unsigned char*)checkedAlloc(calloc(e->nameCount, 1));
+    full.vars = (int*)checkedAlloc(malloc((maxVars + 1) * sizeof(int)));
+    full.stack = (int*)checkedAlloc(malloc(maxDepth * sizeof(int)));
+    for (int i = 0; i < inputs; i++) {
+        sprintf(name, "in%d", i);
+        setInput(e, name, i % 17 + 1);
+        full.values[i] = i % 17 + 1;
+    }
+    recompute(e);
+
+    int deepest = 0;
+    for (int n = 0; n < e->nodeCount; n++)
+        if (e->nodes[n].level > deepest) deepest = e->nodes[n].level;
+    printf("\n%d formulas over %d inputs, e.g. f1234 = ", formulas, inputs);
+    unsigned int seed = 7919u * 1234 + 3;
+    writeFormula(text, &seed, 3, inputs, 1234);
+    printf("%s\n%d DAG nodes, %d levels deep\n", text, e->nodeCount, deepest + 1);
+    benchmark(e, &full, inputs, 200, 20000);
+
+    // Both sides must agree on every formula
+    evaluateAll(&full);
+    int mismatches = 0;
+    for (int i = 0; i < formulas; i++) {
+        int value = 0;
+        sprintf(name, "f%d", i);
+        enum ExprStatus status = getValue(e, name, &value);
+        int k = full.formulaId[i];
+        if ((status != EXPR_OK) != full.failed[k] || (status == EXPR_OK && value != full.values[k]))
+            mismatches++;
+    }
+    printf("  %d of %d formulas differ from a full re-evaluation\n", mismatches, formulas);
+
+    for (int i = 0; i < formulas; i++) {
+        freeProgram(full.programs[i]);
+        free(full.varIds[i]);
+    }
+    free(full.programs);
+    free(full.varIds);
+    free(full.formulaId);
+    free(full.values);
+    free(full.failed);
+    free(full.vars);
+    free(full.stack);
+    freeEngine(e);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    Formulas: 15 nodes for 5 formulas
+    All inputs set: 9 nodes evaluated
+      subtotal = 100  tax = 8  total = 108  perUnit = 27  margin = 40
+    rate = 10: 5 nodes evaluated
+      subtotal = 100  tax = 10  total = 110  perUnit = 27  margin = 40
+    discount = 5: 3 nodes evaluated
+      subtotal = 100  tax = 10  total = 105  perUnit = 26  margin = 35
+    qty = 0: 8 nodes evaluated
+      subtotal = 0  tax = 0  total = -5  perUnit = #DIV/0  margin = -5
+    qty = 4: 8 nodes evaluated
+      subtotal = 100  tax = 10  total = 105  perUnit = 26  margin = 35
+    cost = 15 (unchanged): 0 nodes evaluated
+    loop = loop + 1 rejected
+    a_name_longer_than_the_32_byte_slot rejected (errorPos -1)
+    net-price rejected (errorPos -1)
+
+    20000 formulas over 1000 inputs, e.g. f1234 = (((in88 * f1119) / in232) - (f1176 + (f1126 * in737)))
+    70196 DAG nodes, 875 levels deep
+      rare input   incremental     2015.6 ns,     67.3 nodes per update
+      random input incremental    17886.6 ns,    124.7 nodes per update
+      hot input    incremental   166529.2 ns,   3592.5 nodes per update
+      any input    full pass    2248415.3 ns,    20000 formulas per update
+      0 of 20000 formulas differ from a full re-evaluation
+*/
@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>   // for isdigit(), isspace()
+#include <string.h>  // for strlen()
+#include <time.h>    // for clock_gettime()
+
+#define SIZE 256     // Maximum depth of each stack
+
+/*
+    Direct infix evaluation with two stacks.
+
+    InfixToPostfix.c writes a postfix string and PostfixEvaluation.c scans
+    it again. Here both run in the same pass over the infix text: numbers
+    go onto a value stack, and whenever the shunting-yard algorithm would
+    append an operator to the postfix output, that operator is applied to
+    the value stack instead (reduce()). There is no postfix buffer.
+
+    Numbers are multi-digit, whitespace is skipped, and operators are
+    + - * / % ^ and unary minus. ^ is right-associative and binds tighter
+    than unary minus, so -2^2 is -4 and 2^3^2 is 2^9.
+*/
+
+int values[SIZE];    // Value stack
+int valueTop = -1;
+char ops[SIZE];      // Operator stack; '~' is unary minus
+int opTop = -1;
+
+// Function to push a value onto the value stack
+void pushValue(int val) {
+    if (valueTop >= SIZE - 1) {
+        printf("Stack Overflow\n");
+        exit(1);
+    }
+    values[++valueTop] = val;
+}
+
+// Function to pop a value from the value stack
+int popValue() {
+    if (valueTop == -1) {
+        printf("Stack Underflow\n");
+        exit(1);
+    }
+    return values[valueTop--];
+}
+
+// Function to push an operator onto the operator stack
+void pushOp(char op) {
+    if (opTop >= SIZE - 1) {
+        printf("Stack Overflow\n");
+        exit(1);
+    }
+    ops[++opTop] = op;
+}
+
+// Function to return precedence of operators
+int precedence(char op) {
+    if (op == '^') return 4;
+    if (op == '~') return 3;
+    if (op == '*' || op == '/' || op == '%') return 2;
+    if (op == '+' || op == '-') return 1;
+    return 0;
+}
+
+// Integer power by squaring; a negative exponent truncates toward zero
+int power(int base, int exp) {
+    unsigned int result = 1, b = (unsigned int)base;
+    if (exp < 0)
+        return base == 1 ? 1 : base == -1 ? (exp & 1 ? -1 : 1) : 0;
+    while (exp) {
+        if (exp & 1) result *= b;
+        b *= b;
+        exp >>= 1;
+    }
+    return (int)result;
+}
+
+// Apply a binary operator; + - * wrap around on overflow
+int applyOperator(char op, int val1, int val2) {
+    switch (op) {
+        case '+': return (int)((unsigned int)val1 + (unsigned int)val2);
+        case '-': return (int)((unsigned int)val1 - (unsigned int)val2);
+        case '*': return (int)((unsigned int)val1 * (unsigned int)val2);
+        case '^': return power(val1, val2);
+        case '/':
+            if (val2 == 0) {
+                printf("Division by zero error!\n");
+                exit(1);
+            }
+            return val2 == -1 ? (int)(0u - (unsigned int)val1) : val1 / val2;
+        case '%':
+            if (val2 == 0) {
+                printf("Modulo by zero error!\n");
+                exit(1);
+            }
+            return val2 == -1 ? 0 : val1 % val2;
+    }
+    printf("Invalid operator: %c\n", op);
+    exit(1);
+}
+
+// Pop the top operator and apply it to the value stack
+void reduce() {
+    char op = ops[opTop--];
+    if (op == '~') {
+        pushValue((int)(0u - (unsigned int)popValue()));
+    } else {
+        int val2 = popValue();
+        int val1 = popValue();
+        pushValue(applyOperator(op, val1, val2));
+    }
+}
+
+void invalidExpression(int position) {
+    printf("Invalid expression at position %d\n", position);
+    exit(1);
+}
+
+// Function to evaluate an infix expression in one pass
+int evaluateInfix(const char* expr) {
+    int expectOperand = 1;   // Start, or after '(' or an operator
+    int i = 0;
+
+    valueTop = -1;
+    opTop = -1;
+    while (expr[i] != '\0') {
+        char ch = expr[i];
+
+        if (isspace((unsigned char)ch)) {
+            i++;
+        } else if (isdigit((unsigned char)ch)) {
+            unsigned int num = 0;
+            if (!expectOperand)
+                invalidExpression(i);
+            while (isdigit((unsigned char)expr[i]))
+                num = num * 10 + (expr[i++] - '0');
+            pushValue((int)num);
+            expectOperand = 0;
+        } else if (ch == '(') {
+            if (!expectOperand)
+                invalidExpression(i);
+            pushOp(ch);
+            i++;
+        } else if (ch == ')') {
+            if (expectOperand)
+                invalidExpression(i);
+            while (opTop >= 0 && ops[opTop] != '(')
+                reduce();
+            if (opTop < 0)
+                invalidExpression(i);   // No matching '('
+            opTop--;
+            i++;
+        } else if (expectOperand && (ch == '-' || ch == '+')) {
+            // Unary sign: a prefix operator never reduces anything
+            if (ch == '-')
+                pushOp('~');
+            i++;
+        } else if (precedence(ch) > 0 && ch != '~') {
+            if (expectOperand)
+                invalidExpression(i);
+            // Reduce tighter operators, and equal ones unless 'ch' is right-associative
+            while (opTop >= 0 && ops[opTop] != '(' &&
+                   (precedence(ops[opTop]) > precedence(ch) ||
+                    (precedence(ops[opTop]) == precedence(ch) && ch != '^')))
+                reduce();
+            pushOp(ch);
+            expectOperand = 1;
+            i++;
+        } else {
+            invalidExpression(i);
+        }
+    }
+    if (expectOperand)
+        invalidExpression(i);           // Empty input or trailing operator
+    while (opTop >= 0) {
+        if (ops[opTop] == '(')
+            invalidExpression(i);       // Unclosed '('
+        reduce();
+    }
+    return popValue();
+}
+
+/*
+    The two-pass pipeline for comparison: infixToPostfix() with multi-digit
+    numbers and unary minus, writing space-separated tokens into a buffer,
+    then evaluatePostfix() scanning that buffer. Input is assumed valid.
+*/
+void infixToPostfix(const char* infix, char* postfix) {
+    int expectOperand = 1, j = 0;
+
+    opTop = -1;
+    for (int i = 0; infix[i] != '\0'; i++) {
+        char ch = infix[i];
+        if (isspace((unsigned char)ch))
+            continue;
+        if (isdigit((unsigned char)ch)) {
+            while (isdigit((unsigned char)infix[i]))
+                postfix[j++] = infix[i++];
+            i--;
+            postfix[j++] = ' ';
+            expectOperand = 0;
+        } else if (ch == '(') {
+            pushOp(ch);
+        } else if (ch == ')') {
+            while (ops[opTop] != '(') {
+                postfix[j++] = ops[opTop--];
+                postfix[j++] = ' ';
+            }
+            opTop--;
+        } else if (expectOperand) {
+            if (ch == '-')
+                pushOp('~');
+        } else {
+            while (opTop >= 0 && ops[opTop] != '(' &&
+                   (precedence(ops[opTop]) > precedence(ch) ||
+                    (precedence(ops[opTop]) == precedence(ch) && ch != '^'))) {
+                postfix[j++] = ops[opTop--];
+                postfix[j++] = ' ';
+            }
+            pushOp(ch);
+            expectOperand = 1;
+        }
+    }
+    while (opTop >= 0) {
+        postfix[j++] = ops[opTop--];
+        postfix[j++] = ' ';
+    }
+    postfix[j] = '\0';
+}
+
+int evaluatePostfix(const char* expr) {
+    valueTop = -1;
+    for (int i = 0; expr[i] != '\0'; i++) {
+        char ch = expr[i];
+        if (ch == ' ')
+            continue;
+        if (isdigit((unsigned char)ch)) {
+            unsigned int num = 0;
+            while (isdigit((unsigned char)expr[i]))
+                num = num * 10 + (expr[i++] - '0');
+            i--;
+            pushValue((int)num);
+        } else if (ch == '~') {
+            pushValue((int)(0u - (unsigned int)popValue()));
+        } else {
+            int val2 = popValue();
+            int val1 = popValue();
+            pushValue(applyOperator(ch, val1, val2));
+        }
+    }
+    return popValue();
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Evaluate 'expr' 'repeat' times both ways
+void benchmark(const char* label, const char* expr, int repeat) {
+    char* postfix = (char*)malloc(2 * strlen(expr) + 2);   // Every token plus a space
+    long long direct = 0, twoPass = 0;
+
+    double start = nowNs();
+    for (int r = 0; r < repeat; r++)
+        direct += evaluateInfix(expr);
+    double directNs = (nowNs() - start) / repeat;
+
+    start = nowNs();
+    for (int r = 0; r < repeat; r++) {
+        infixToPostfix(expr, postfix);
+        twoPass += evaluatePostfix(postfix);
+    }
+    double twoPassNs = (nowNs() - start) / repeat;
+
+    printf("  %-30s %7zu chars: two-pass %10.1f ns, direct %10.1f ns, %4.2fx  (%s)\n",
+           label, strlen(expr), twoPassNs, directNs, twoPassNs / directNs,
+           direct == twoPass ? "same results" : "MISMATCH");
+    free(postfix);
+}
+
+// Driver Code
+int main() {
+    const char* examples[] = {
+        "2 + 3 * 4",
+        "(2 + 3) * 4",
+        "100 / (4 + 6) - 7 % 3",
+        "-2 ^ 2 + 2 ^ 3 ^ 2",
+        "-(12 - 20) * --3",
+        "  250*4 - 250*4*15/100  ",
+    };
+    for (int k = 0; k < 6; k++)
+        printf("%-26s = %d\n", examples[k], evaluateInfix(examples[k]));
+
+    // A long flat formula: 20000 terms "123 * 45 - 6 + 7890 / 12 % 5 ..."
+    const char* pieces[] = {"123", " * ", "45", " - ", "6", " + ", "7890", " / ", "12", " % ", "5", " + "};
+    char* longExpr = (char*)malloc(20000 * 8);
+    int len = 0;
+    for (int t = 0; t < 20000; t++)
+        len += sprintf(longExpr + len, "%s%s", pieces[(2 * t) % 12], t == 19999 ? "" : pieces[(2 * t + 1) % 12]);
+
+    printf("\nTime per evaluation:\n");
+    benchmark("2 + 3 * 4", "2 + 3 * 4", 1000000);
+    benchmark("(12 + 34) * (56 - 7) / 3 ...", "(12 + 34) * (56 - 7) / 3 - 2 ^ 10 % 7 + -(8 * 9)", 1000000);
+    benchmark("20000-term formula", longExpr, 200);
+    free(longExpr);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    2 + 3 * 4                  = 14
+    (2 + 3) * 4                = 20
+    100 / (4 + 6) - 7 % 3      = 9
+    -2 ^ 2 + 2 ^ 3 ^ 2         = 508
+    -(12 - 20) * --3           = 24
+      250*4 - 250*4*15/100     = 850
+
+    Time per evaluation:
+      2 + 3 * 4                            9 chars: two-pass       54.6 ns, direct       33.7 ns, 1.62x  (same results)
+      (12 + 34) * (56 - 7) / 3 ...        48 chars: two-pass      266.2 ns, direct      185.0 ns, 1.44x  (same results)
+      20000-term formula              103331 chars: two-pass   517352.4 ns, direct   338270.8 ns, 1.53x  (same results)
+*/
@@ -0,0 +1,267 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>  // for atomic_compare_exchange_weak_explicit()
+#include <pthread.h>    // for pthread_create()
+#include <sched.h>      // for sched_yield()
+#include <time.h>       // for clock_gettime()
+
+#define CACHE_LINE 64          // Size of one cache line in bytes
+#define QUEUE_CAPACITY 1024    // Ring capacity, must be a power of two
+#define MAX_CAPACITY (1u << 31) // Largest power of two an unsigned int holds
+#define OPS_PER_THREAD 2000000 // Enqueue/dequeue pairs per benchmark thread
+#define MAX_THREADS 64
+
+// Result of a queue operation, returned instead of printing "Queue Overflow"
+enum QueueStatus {
+    QUEUE_OK = 0,
+    QUEUE_FULL,
+    QUEUE_EMPTY
+};
+
+/*
+    Bounded multi-producer/multi-consumer queue.
+
+    Every slot carries a sequence number that tells which lap of the ring it
+    belongs to. For position pos:
+        seq == pos      slot is free, a producer may claim it
+        seq == pos + 1  slot holds data, a consumer may claim it
+    Producers and consumers claim a position with one CAS on tail or head and
+    then hand the slot over by publishing the next sequence number, so there
+    is no global lock and a stalled thread only blocks its own slot.
+*/
+struct Slot {
+    atomic_uint seq;
+    atomic_int value;   // Accessed relaxed; seq orders it, peek() re-checks head
+};
+
+struct MpmcQueue {
+    _Alignas(CACHE_LINE) atomic_uint tail;   // Next position to enqueue
+    _Alignas(CACHE_LINE) atomic_uint head;   // Next position to dequeue
+    _Alignas(CACHE_LINE) struct Slot* slots;
+    unsigned int mask;
+};
+
+// Round a requested capacity up to the next power of two; 0 if above MAX_CAPACITY
+static unsigned int roundUpPowerOfTwo(unsigned int x) {
+    unsigned int cap = 1;
+    if (x > MAX_CAPACITY)
+        return 0;
+    while (cap < x)
+        cap <<= 1;
+    return cap;
+}
+
+// Create an MPMC queue holding at least 'capacity' elements (rounded up to a
+// power of two); NULL if capacity is 0 or above MAX_CAPACITY
+struct MpmcQueue* createMpmcQueue(unsigned int capacity) {
+    capacity = capacity ? roundUpPowerOfTwo(capacity) : 0;
+    if (capacity == 0)
+        return NULL;
+    struct MpmcQueue* q = (struct MpmcQueue*)aligned_alloc(CACHE_LINE, sizeof(struct MpmcQueue));
+    if (q == NULL)
+        return NULL;
+    q->slots = (struct Slot*)malloc((size_t)capacity * sizeof(struct Slot));
+    if (q->slots == NULL) {
+        free(q);
+        return NULL;
+    }
+    for (unsigned int i = 0; i < capacity; i++)
+        atomic_init(&q->slots[i].seq, i);
+    q->mask = capacity - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    return q;
+}
+
+// Release the queue and its storage
+void freeMpmcQueue(struct MpmcQueue* q) {
+    if (q == NULL) return;
+    free(q->slots);
+    free(q);
+}
+
+// Enqueue operation: Adds an element to the rear, QUEUE_FULL if no slot is free
+enum QueueStatus enqueue(struct MpmcQueue* q, int x) {
+    unsigned int pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    struct Slot* slot;
+
+    for (;;) {
+        slot = &q->slots[pos & q->mask];
+        unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+        if (diff == 0) {
+            // Slot is free on this lap: try to claim the position
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // Slot still holds data from the previous lap: queue is full
+            return QUEUE_FULL;
+        } else {
+            // Another producer took this position, retry with the new tail
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+
+    atomic_store_explicit(&slot->value, x, memory_order_relaxed);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return QUEUE_OK;
+}
+
+// Dequeue operation: Removes the front element into *x, QUEUE_EMPTY if there is none
+enum QueueStatus dequeue(struct MpmcQueue* q, int* x) {
+    unsigned int pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    struct Slot* slot;
+
+    for (;;) {
+        slot = &q->slots[pos & q->mask];
+        unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int diff = (int)(seq - (pos + 1));
+        if (diff == 0) {
+            // Slot holds data for this position: try to claim it
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // Producer has not filled the slot yet: queue is empty
+            return QUEUE_EMPTY;
+        } else {
+            // Another consumer took this position, retry with the new head
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+
+    *x = atomic_load_explicit(&slot->value, memory_order_relaxed);
+    // Free the slot for the producer one lap ahead
+    atomic_store_explicit(&slot->seq, pos + q->mask + 1, memory_order_release);
+    return QUEUE_OK;
+}
+
+// Peek operation: Reads the front element without removing it. With other
+// consumers running the value is a snapshot and may be taken right after.
+enum QueueStatus peek(struct MpmcQueue* q, int* x) {
+    for (;;) {
+        unsigned int pos = atomic_load_explicit(&q->head, memory_order_acquire);
+        struct Slot* slot = &q->slots[pos & q->mask];
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos + 1)
+            return QUEUE_EMPTY;
+        // Seqlock-style read: the fence keeps the value load ahead of the
+        // re-check, and the value is only valid if nobody dequeued the
+        // position meanwhile (a producer may already be refilling the slot)
+        int value = atomic_load_explicit(&slot->value, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&q->head, memory_order_relaxed) == pos) {
+            *x = value;
+            return QUEUE_OK;
+        }
+    }
+}
+
+// isEmpty operation: Checks if the queue is empty (snapshot)
+int isEmpty(struct MpmcQueue* q) {
+    unsigned int pos = atomic_load_explicit(&q->head, memory_order_acquire);
+    return atomic_load_explicit(&q->slots[pos & q->mask].seq, memory_order_acquire) != pos + 1;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Benchmark worker: each thread alternates enqueue and dequeue on the shared queue
+struct Worker {
+    pthread_t thread;
+    struct MpmcQueue* q;
+    int id;
+    long long sum;
+};
+
+static void* worker(void* arg) {
+    struct Worker* w = (struct Worker*)arg;
+    long long sum = 0;
+    int x;
+
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+        while (enqueue(w->q, w->id) != QUEUE_OK)
+            sched_yield();
+        while (dequeue(w->q, &x) != QUEUE_OK)
+            sched_yield();
+        sum += x;
+    }
+    w->sum = sum;
+    return NULL;
+}
+
+// Run the balanced workload with 'threads' threads and print throughput
+void benchmark(int threads) {
+    struct MpmcQueue* q = createMpmcQueue(QUEUE_CAPACITY);
+    struct Worker workers[MAX_THREADS];
+    long long sum = 0, expected = 0;
+    int i;
+
+    double start = nowNs();
+    for (i = 0; i < threads; i++) {
+        workers[i].q = q;
+        workers[i].id = i + 1;
+        pthread_create(&workers[i].thread, NULL, worker, &workers[i]);
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        sum += workers[i].sum;
+        expected += (long long)(i + 1) * OPS_PER_THREAD;
+    }
+    double elapsed = nowNs() - start;
+    double ops = 2.0 * OPS_PER_THREAD * threads;
+
+    printf("%3d thread(s): %8.2f Mops/s  %s\n", threads, ops / elapsed * 1e3,
+           sum == expected && isEmpty(q) ? "ok" : "CHECKSUM MISMATCH");
+    freeMpmcQueue(q);
+}
+
+// Driver Code: optional argument is the highest thread count to benchmark
+int main(int argc, char* argv[]) {
+    struct MpmcQueue* q = createMpmcQueue(2);
+    int maxThreads = argc > 1 ? atoi(argv[1]) : 8;
+    int x;
+
+    if (maxThreads < 1) maxThreads = 1;
+    if (maxThreads > MAX_THREADS) maxThreads = MAX_THREADS;
+
+    enqueue(q, 10);
+    enqueue(q, 20);
+    if (enqueue(q, 30) == QUEUE_FULL)
+        printf("Queue is full, 30 not enqueued\n");
+
+    if (peek(q, &x) == QUEUE_OK)
+        printf("Front element is %d\n", x);
+
+    while (dequeue(q, &x) == QUEUE_OK)
+        printf("Dequeued element is %d\n", x);
+
+    if (isEmpty(q))
+        printf("Queue is empty\n");
+    freeMpmcQueue(q);
+
+    printf("\nScaling, %d enqueue/dequeue pairs per thread:\n", OPS_PER_THREAD);
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+        benchmark(threads);
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine and core count):
+    --------------------------------
+    Queue is full, 30 not enqueued
+    Front element is 10
+    Dequeued element is 10
+    Dequeued element is 20
+    Queue is empty
+
+    Scaling, 2000000 enqueue/dequeue pairs per thread:
+      1 thread(s):    84.86 Mops/s  ok
+      2 thread(s):    92.32 Mops/s  ok
+      4 thread(s):    87.07 Mops/s  ok
+      8 thread(s):    89.56 Mops/s  ok
+*/
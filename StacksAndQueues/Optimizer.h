@@ -0,0 +1,311 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <stdlib.h>
+#include <string.h>      // for memcpy()
+#include "Bytecode.h"    // for struct Program, bcEmit() and bcPower()
+#include "../LinkedList/OpenAddressing.h"  // for homeSlot() and hashShift()
+
+/*
+    Optimization pass over compiled postfix programs.
+
+    The postfix sequence is replayed on a stack of DAG node numbers instead
+    of values. Every node is looked up in a hash table before it is created,
+    so a repeated subexpression becomes one node with several parents
+    (common subexpression elimination). Commutative operands are put in a
+    fixed order first, so b*a finds a*b. While a node is created it is also
+    simplified:
+
+        constant folding      2*3+1 -> 7, also (x+2)+3 -> x+5, (x*2)*3 -> x*6
+        identities            x+0, x-0, x*1, x/1, x^1 -> x;  x*0 -> 0;  x-x -> 0
+        strength reduction    x*2 -> x+x,  x^2 -> x*x,  x*-1 -> neg x
+
+    Strength reduction is the last rewrite tried for a node, after the
+    constant chains, and a multiply by a constant also looks through x+x as
+    x*2, so x*2*3 and x*3*2 both end up as x*6.
+
+    + - * wrap around in runProgram(), so regrouping them never changes a
+    result. A rewrite that would drop a division whose divisor is not a
+    known non-zero constant (x*0 with x = a/b) is skipped: the optimized
+    program must fail exactly when the original does.
+
+    Code generation walks the DAG from the root. A node used twice by the
+    same parent (x+x) is emitted once followed by DUP; a node with several
+    parents is STOREd into a reuse slot after its first evaluation and
+    LOADed afterwards, or DUPed when the only later use comes right away.
+    Slots are recycled after their last use.
+*/
+
+struct DagNode {
+    unsigned char op;        // enum OpCode
+    int operand;             // Constant value or variable index
+    int left, right;         // Child nodes, -1 if none; always below this node
+    int mayFail;             // The subtree divides by something that may be 0
+};
+
+struct Dag {
+    struct DagNode* nodes;
+    int count, capacity;
+    int* table;              // Open addressing over node numbers, -1 empty
+    int mask;
+    int shift;               // 32 - log2(table size)
+};
+
+static inline unsigned int dagHash(int op, int operand, int left, int right) {
+    unsigned int h = (unsigned int)op;
+    h = h * 31 + (unsigned int)operand;
+    h = h * 31 + (unsigned int)left;
+    h = h * 31 + (unsigned int)right;
+    return h * 2654435769u;
+}
+
+// Node (op, operand, left, right), created only if no identical node exists
+static inline int dagNode(struct Dag* d, int op, int operand, int left, int right) {
+    unsigned int i = homeSlot(dagHash(op, operand, left, right), d->shift);
+    for (;; i++) {
+        int n = d->table[i & d->mask];
+        if (n < 0)
+            break;
+        struct DagNode* node = &d->nodes[n];
+        if (node->op == op && node->operand == operand && node->left == left && node->right == right)
+            return n;
+    }
+
+    struct DagNode* node = &d->nodes[d->count];
+    node->op = (unsigned char)op;
+    node->operand = operand;
+    node->left = left;
+    node->right = right;
+    node->mayFail = (left >= 0 && d->nodes[left].mayFail) || (right >= 0 && d->nodes[right].mayFail);
+    if ((op == OP_DIV || op == OP_MOD) && right >= 0 &&
+        !(d->nodes[right].op == OP_CONST && d->nodes[right].operand != 0))
+        node->mayFail = 1;
+    d->table[i & d->mask] = d->count;
+    return d->count++;
+}
+
+static inline int dagConst(struct Dag* d, int value) {
+    return dagNode(d, OP_CONST, value, -1, -1);
+}
+
+// Evaluate a constant operator like runProgram(); returns 0 for division by zero
+static inline int foldConstant(int op, int a, int b, int* result) {
+    switch (op) {
+        case OP_ADD: *result = (int)((unsigned int)a + (unsigned int)b); return 1;
+        case OP_SUB: *result = (int)((unsigned int)a - (unsigned int)b); return 1;
+        case OP_MUL: *result = (int)((unsigned int)a * (unsigned int)b); return 1;
+        case OP_POW: *result = bcPower(a, b); return 1;
+        case OP_DIV:
+        case OP_MOD:
+            if (b == 0) return 0;
+            if (b == -1) *result = op == OP_MOD ? 0 : (int)(0u - (unsigned int)a);
+            else *result = op == OP_MOD ? a % b : a / b;
+            return 1;
+    }
+    return 0;
+}
+
+// Node for 'op' applied to 'left' (and 'right'), simplified where possible
+static inline int dagBuild(struct Dag* d, int op, int left, int right) {
+    const struct DagNode* N = d->nodes;
+    int value;
+
+    if (op == OP_NEG) {
+        if (N[left].op == OP_CONST)
+            return dagConst(d, (int)(0u - (unsigned int)N[left].operand));
+        if (N[left].op == OP_NEG)
+            return N[left].left;                      // --x -> x
+        return dagNode(d, OP_NEG, 0, left, -1);
+    }
+    if (N[left].op == OP_CONST && N[right].op == OP_CONST &&
+        foldConstant(op, N[left].operand, N[right].operand, &value))
+        return dagConst(d, value);
+
+    // Commutative: constant on the right, otherwise lower node first
+    if ((op == OP_ADD || op == OP_MUL) &&
+        (N[left].op == OP_CONST || (N[right].op != OP_CONST && left > right))) {
+        int t = left;
+        left = right;
+        right = t;
+    }
+    int rightConst = N[right].op == OP_CONST;
+    int c = N[right].operand;
+
+    switch (op) {
+        case OP_ADD:
+            if (rightConst && c == 0) return left;
+            if (rightConst && N[left].op == OP_ADD && N[N[left].right].op == OP_CONST)
+                return dagBuild(d, OP_ADD, N[left].left,
+                                dagConst(d, (int)((unsigned int)N[N[left].right].operand + (unsigned int)c)));
+            if (N[right].op == OP_NEG) return dagBuild(d, OP_SUB, left, N[right].left);
+            break;
+        case OP_SUB:
+            if (left == right && !N[left].mayFail) return dagConst(d, 0);
+            if (rightConst) return dagBuild(d, OP_ADD, left, dagConst(d, (int)(0u - (unsigned int)c)));
+            if (N[left].op == OP_CONST && N[left].operand == 0) return dagBuild(d, OP_NEG, right, -1);
+            if (N[right].op == OP_NEG) return dagBuild(d, OP_ADD, left, N[right].left);
+            break;
+        case OP_MUL:
+            if (rightConst && c == 1) return left;
+            if (rightConst && c == 0 && !N[left].mayFail) return right;
+            if (rightConst && c == -1) return dagBuild(d, OP_NEG, left, -1);
+            if (rightConst && N[left].op == OP_MUL && N[N[left].right].op == OP_CONST)
+                return dagBuild(d, OP_MUL, N[left].left,
+                                dagConst(d, (int)((unsigned int)N[N[left].right].operand * (unsigned int)c)));
+            if (rightConst && N[left].op == OP_ADD && N[left].left == N[left].right)
+                return dagBuild(d, OP_MUL, N[left].left, dagConst(d, (int)(2u * (unsigned int)c)));
+            if (rightConst && c == 2) return dagBuild(d, OP_ADD, left, left);
+            break;
+        case OP_DIV:
+            if (rightConst && c == 1) return left;
+            if (rightConst && c == -1) return dagBuild(d, OP_NEG, left, -1);
+            break;
+        case OP_MOD:
+            if (rightConst && (c == 1 || c == -1) && !N[left].mayFail) return dagConst(d, 0);
+            break;
+        case OP_POW:
+            if (rightConst && c == 1) return left;
+            if (rightConst && c == 0 && !N[left].mayFail) return dagConst(d, 1);
+            if (rightConst && c == 2) return dagBuild(d, OP_MUL, left, left);
+            break;
+    }
+    return dagNode(d, op, 0, left, right);
+}
+
+// Code generation state: per node remaining uses and reuse slot, plus free slots
+struct DagEmitter {
+    struct Program* out;
+    int depth;
+    int* uses;
+    int* slotOf;
+    int* freeSlots;
+    int freeCount;
+};
+
+static inline void dagEmit(struct Dag* d, struct DagEmitter* e, int n) {
+    const struct DagNode* node = &d->nodes[n];
+
+    if (e->slotOf[n] >= 0) {
+        struct Program* out = e->out;
+        int last = --e->uses[n] == 0;
+        if (last)
+            e->freeSlots[e->freeCount++] = e->slotOf[n];
+        // "store s, load s" for the last use is just "dup"
+        if (last && out->ops[out->length - 1] == OP_STORE && out->operands[out->length - 1] == e->slotOf[n]) {
+            out->length--;
+            bcEmit(out, OP_DUP, 0, &e->depth);
+        } else {
+            bcEmit(out, OP_LOAD, e->slotOf[n], &e->depth);
+        }
+        return;
+    }
+    if (node->left < 0) {
+        bcEmit(e->out, (enum OpCode)node->op, node->operand, &e->depth);
+        return;
+    }
+    dagEmit(d, e, node->left);
+    if (node->right >= 0) {
+        if (node->right == node->left)
+            bcEmit(e->out, OP_DUP, 0, &e->depth);
+        else
+            dagEmit(d, e, node->right);
+    }
+    bcEmit(e->out, (enum OpCode)node->op, 0, &e->depth);
+
+    // Leaves are pushed again instead; anything else used later is kept
+    if (--e->uses[n] > 0) {
+        int slot = e->freeCount > 0 ? e->freeSlots[--e->freeCount] : e->out->slotCount++;
+        e->slotOf[n] = slot;
+        bcEmit(e->out, OP_STORE, slot, &e->depth);
+    }
+}
+
+// Optimized copy of 'p'; returns NULL if memory runs out. 'p' is not changed.
+static inline struct Program* optimizeProgram(const struct Program* p) {
+    struct Dag d;
+    struct Program* out = (struct Program*)calloc(1, sizeof(struct Program));
+    struct DagEmitter e = {0};
+    int* stack = (int*)malloc(p->length * sizeof(int));
+    int top = -1;
+
+    // Each instruction creates at most a few nodes (a folded constant, a swap, the node)
+    d.capacity = 4 * p->length + 4;
+    d.count = 0;
+    d.mask = 1;
+    while (d.mask < 2 * d.capacity)
+        d.mask <<= 1;
+    d.nodes = (struct DagNode*)malloc(d.capacity * sizeof(struct DagNode));
+    d.table = (int*)malloc(d.mask * sizeof(int));
+    d.shift = hashShift((uint32_t)d.mask);
+    d.mask--;
+    if (out == NULL || stack == NULL || d.nodes == NULL || d.table == NULL)
+        goto fail;
+    memset(d.table, 0xff, (d.mask + 1) * sizeof(int));
+
+    for (int pc = 0; pc < p->length; pc++) {
+        int op = p->ops[pc];
+        if (op == OP_CONST || op == OP_VAR) {
+            stack[++top] = dagNode(&d, op, p->operands[pc], -1, -1);
+        } else if (op == OP_NEG) {
+            stack[top] = dagBuild(&d, OP_NEG, stack[top], -1);
+        } else if (op == OP_DUP) {
+            stack[top + 1] = stack[top];
+            top++;
+        } else if (op >= OP_ADD && op <= OP_POW) {
+            top--;
+            stack[top] = dagBuild(&d, op, stack[top], stack[top + 1]);
+        } else {
+            goto fail;                        // Already uses reuse slots
+        }
+    }
+    int root = stack[top];
+
+    // Count the parents of every node reachable from the root; x+x counts once
+    e.uses = (int*)calloc(d.count, sizeof(int));
+    e.slotOf = (int*)malloc(d.count * sizeof(int));
+    e.freeSlots = (int*)malloc(d.count * sizeof(int));
+    // Per node at most its operator, a DUP, a STORE and a LOAD for each of two children
+    out->ops = (unsigned char*)malloc(5 * d.count);
+    out->operands = (int*)malloc(5 * d.count * sizeof(int));
+    out->varNames = (char (*)[BC_MAX_NAME])malloc((p->varCount + 1) * BC_MAX_NAME);
+    if (e.uses == NULL || e.slotOf == NULL || e.freeSlots == NULL ||
+        out->ops == NULL || out->operands == NULL || out->varNames == NULL)
+        goto fail;
+    e.uses[root] = 1;
+    for (int n = root; n >= 0; n--) {
+        if (e.uses[n] == 0)
+            continue;
+        if (d.nodes[n].left >= 0)
+            e.uses[d.nodes[n].left]++;
+        if (d.nodes[n].right >= 0 && d.nodes[n].right != d.nodes[n].left)
+            e.uses[d.nodes[n].right]++;
+    }
+    memset(e.slotOf, 0xff, d.count * sizeof(int));
+
+    e.out = out;
+    dagEmit(&d, &e, root);
+    out->maxDepth += out->slotCount;
+    out->varCount = p->varCount;
+    if (p->varCount > 0)
+        memcpy(out->varNames, p->varNames, p->varCount * BC_MAX_NAME);
+
+    free(e.uses);
+    free(e.slotOf);
+    free(e.freeSlots);
+    free(d.nodes);
+    free(d.table);
+    free(stack);
+    return out;
+
+fail:
+    free(e.uses);
+    free(e.slotOf);
+    free(e.freeSlots);
+    free(d.nodes);
+    free(d.table);
+    free(stack);
+    freeProgram(out);
+    return NULL;
+}
+
+#endif // OPTIMIZER_H
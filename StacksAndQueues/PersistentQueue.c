@@ -0,0 +1,410 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>     // for offsetof()
+#include <stdint.h>     // for uint32_t, uint64_t
+#include <string.h>     // for memcmp(), memcpy()
+#include <time.h>       // for clock_gettime()
+#include <fcntl.h>      // for open()
+#include <unistd.h>     // for ftruncate(), close(), unlink()
+#include <sys/mman.h>   // for mmap(), msync()
+#include <sys/stat.h>   // for fstat()
+
+/*
+    Persistent version of the ring buffer queue in Queue.c, stored in a
+    memory-mapped file and used in place. Reopening the file maps it and
+    checks one header: O(1), no replay of enqueue() calls.
+
+    File layout (version 1):
+
+        0     header slot A   (512 bytes, one disk sector)
+        512   header slot B
+        4096  ring: capacity x struct Slot, capacity a power of two
+
+    head and tail run freely and are masked on access, exactly as in Queue.c.
+    They live in the header, so the header alone says which slots are live.
+
+    Crash safety: a commit writes the new header (sequence + 1, CRC32) into
+    the slot the current header is NOT in; opening takes the valid slot with
+    the higher sequence, so a torn header write falls back to the previous
+    state. enqueue() fills the slot at 'tail', which no committed state
+    references, before the commit that moves 'tail'; dequeue() only commits
+    a new 'head'. Growing copies the wrapped prefix into the newly added part
+    of the file and commits the new capacity, never touching live slots.
+
+    Checksums: each slot stores a CRC32 of its value and its enqueue number
+    (a 64-bit count in the header), so verifyQueue() catches both damaged
+    values and stale slots from an earlier lap around the ring.
+
+    With 'durable' set, each commit msync()s the written slot before the
+    header and the header after it, so the order also holds across power loss.
+*/
+
+#define FILE_VERSION 1
+#define HEADER_SLOT_BYTES 512
+#define RING_OFFSET 4096
+#define INITIAL_CAPACITY 1024   // Must be a power of two
+#define MAX_CAPACITY (1u << 31)  // Largest power of two a uint32_t holds
+
+static const char fileMagic[8] = "DSAQUEU";
+
+// On-disk header, one copy per slot
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t capacity;       // Ring slots, a power of two
+    uint64_t sequence;       // Commit counter; the valid slot with the higher one wins
+    uint64_t enqueued;       // Total enqueues ever, numbers the slots for their CRC
+    uint32_t head;           // Index of the front element (unmasked)
+    uint32_t tail;           // Index one past the rear element (unmasked)
+    uint32_t headerCrc;      // CRC32 of every field above
+};
+
+// On-disk ring slot
+struct Slot {
+    int32_t value;
+    uint32_t crc;            // CRC32 of (enqueue number, value)
+};
+
+// Open queue: the mapping plus a working copy of the header
+struct PersistentQueue {
+    int fd;
+    char* map;
+    size_t mapBytes;
+    struct Slot* slots;
+    struct FileHeader header;    // State to publish on the next commit
+    int durable;                 // msync() on every commit
+};
+
+// CRC-32 (IEEE 802.3, as in zlib); pass 0 to start, the previous result to continue
+static uint32_t crc32(uint32_t crc, const void* buf, size_t len) {
+    static uint32_t table[256];
+    const unsigned char* p = (const unsigned char*)buf;
+
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    while (len--)
+        crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t headerCrc(const struct FileHeader* h) {
+    return crc32(0, h, offsetof(struct FileHeader, headerCrc));
+}
+
+static uint32_t slotCrc(uint64_t number, int32_t value) {
+    return crc32(crc32(0, &number, sizeof(number)), &value, sizeof(value));
+}
+
+static struct FileHeader* headerSlot(struct PersistentQueue* q, int slot) {
+    return (struct FileHeader*)(q->map + slot * HEADER_SLOT_BYTES);
+}
+
+static int headerValid(const struct FileHeader* h) {
+    return memcmp(h->magic, fileMagic, sizeof(fileMagic)) == 0 &&
+           h->version == FILE_VERSION && h->headerCrc == headerCrc(h) &&
+           h->capacity != 0 && (h->capacity & (h->capacity - 1)) == 0;
+}
+
+static size_t fileBytes(uint32_t capacity) {
+    return RING_OFFSET + (size_t)capacity * sizeof(struct Slot);
+}
+
+// Map 'bytes' of the file, replacing any previous mapping
+static int mapFile(struct PersistentQueue* q, size_t bytes) {
+    if (q->map != NULL)
+        munmap(q->map, q->mapBytes);
+    q->map = (char*)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, q->fd, 0);
+    if (q->map == MAP_FAILED) {
+        q->map = NULL;
+        return 0;
+    }
+    q->mapBytes = bytes;
+    q->slots = (struct Slot*)(q->map + RING_OFFSET);
+    return 1;
+}
+
+// Publish the working header into the other slot; 'written' is a slot to flush first, or NULL
+static void commit(struct PersistentQueue* q, struct Slot* written) {
+    struct FileHeader* h = &q->header;
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (q->durable && written != NULL) {
+        uintptr_t at = (uintptr_t)written / page * page;
+        msync((void*)at, page, MS_SYNC);
+    }
+    h->sequence++;
+    h->headerCrc = headerCrc(h);
+    memcpy(headerSlot(q, (int)(h->sequence & 1)), h, sizeof(*h));
+    if (q->durable)
+        msync(q->map, page, MS_SYNC);
+}
+
+void closeQueue(struct PersistentQueue* q) {
+    if (q == NULL) return;
+    if (q->map != NULL)
+        munmap(q->map, q->mapBytes);
+    close(q->fd);
+    free(q);
+}
+
+// Open the queue stored at 'path', creating an empty one if the file does not exist.
+// Returns NULL (with a message) if the file cannot be used.
+struct PersistentQueue* openQueue(const char* path, int durable) {
+    struct PersistentQueue* q = (struct PersistentQueue*)calloc(1, sizeof(struct PersistentQueue));
+    struct stat st;
+
+    if (q == NULL)
+        return NULL;
+    q->durable = durable;
+    q->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (q->fd < 0 || fstat(q->fd, &st) != 0) {
+        perror(path);
+        free(q);
+        return NULL;
+    }
+
+    if (st.st_size == 0) {
+        if (ftruncate(q->fd, (off_t)fileBytes(INITIAL_CAPACITY)) != 0 ||
+            !mapFile(q, fileBytes(INITIAL_CAPACITY))) {
+            perror(path);
+            closeQueue(q);
+            return NULL;
+        }
+        memcpy(q->header.magic, fileMagic, sizeof(fileMagic));
+        q->header.version = FILE_VERSION;
+        q->header.capacity = INITIAL_CAPACITY;
+        q->header.sequence = (uint64_t)-1;    // First commit makes it 0, slot A
+        commit(q, NULL);
+        return q;
+    }
+
+    if ((size_t)st.st_size < RING_OFFSET || !mapFile(q, (size_t)st.st_size)) {
+        printf("%s: not a queue file.\n", path);
+        closeQueue(q);
+        return NULL;
+    }
+    struct FileHeader* a = headerSlot(q, 0);
+    struct FileHeader* b = headerSlot(q, 1);
+    int validA = headerValid(a), validB = headerValid(b);
+    if (!validA && !validB) {
+        printf("%s: no valid header.\n", path);
+        closeQueue(q);
+        return NULL;
+    }
+    q->header = validA && (!validB || a->sequence > b->sequence) ? *a : *b;
+    if (fileBytes(q->header.capacity) > (size_t)st.st_size ||
+        q->header.tail - q->header.head > q->header.capacity) {
+        printf("%s: header does not match the file.\n", path);
+        closeQueue(q);
+        return NULL;
+    }
+    return q;
+}
+
+// Number of elements currently stored in the queue
+unsigned int queueSize(struct PersistentQueue* q) {
+    return q->header.tail - q->header.head;
+}
+
+// Double the capacity, keeping the elements in FIFO order (as growQueue() in Queue.c)
+static int growQueue(struct PersistentQueue* q) {
+    struct FileHeader* h = &q->header;
+    uint32_t oldCapacity = h->capacity;
+    uint32_t front = h->head & (oldCapacity - 1);
+
+    if (oldCapacity >= MAX_CAPACITY)
+        return 0;                       // Doubling would wrap; leave the file alone
+    if (ftruncate(q->fd, (off_t)fileBytes(2 * oldCapacity)) != 0 || !mapFile(q, fileBytes(2 * oldCapacity)))
+        return 0;
+
+    // The wrapped part goes into the new half; live slots are only read
+    memcpy(q->slots + oldCapacity, q->slots, front * sizeof(struct Slot));
+    if (q->durable)
+        msync(q->map, fileBytes(2 * oldCapacity), MS_SYNC);
+
+    h->capacity = 2 * oldCapacity;
+    h->head = front;
+    h->tail = front + oldCapacity;
+    commit(q, NULL);
+    return 1;
+}
+
+// Enqueue operation: Adds an element to the rear of the queue
+void enqueue(struct PersistentQueue* q, int x) {
+    struct FileHeader* h = &q->header;
+    if (h->tail - h->head == h->capacity && !growQueue(q)) {
+        printf("Queue Overflow\n");
+        return;
+    }
+    struct Slot* slot = &q->slots[h->tail & (h->capacity - 1)];
+    slot->value = x;
+    slot->crc = slotCrc(h->enqueued, x);
+    h->enqueued++;
+    h->tail++;
+    commit(q, slot);
+}
+
+// Dequeue operation: Removes and returns the front element of the queue
+int dequeue(struct PersistentQueue* q) {
+    struct FileHeader* h = &q->header;
+    if (h->head == h->tail) {
+        printf("Queue Underflow\n");
+        return -1;
+    }
+    int x = q->slots[h->head & (h->capacity - 1)].value;
+    h->head++;
+    commit(q, NULL);
+    return x;
+}
+
+// Peek operation: Returns the front element without removing it
+int peek(struct PersistentQueue* q) {
+    struct FileHeader* h = &q->header;
+    if (h->head == h->tail) {
+        printf("Queue is Empty\n");
+        return -1;
+    }
+    return q->slots[h->head & (h->capacity - 1)].value;
+}
+
+// isEmpty operation: Checks if the queue is empty
+int isEmpty(struct PersistentQueue* q) {
+    return q->header.head == q->header.tail;
+}
+
+// Full integrity check, O(n): every live slot's CRC against its enqueue number
+int verifyQueue(struct PersistentQueue* q) {
+    struct FileHeader* h = &q->header;
+    uint64_t number = h->enqueued - (h->tail - h->head);
+    for (uint32_t i = h->head; i != h->tail; i++, number++) {
+        struct Slot* slot = &q->slots[i & (h->capacity - 1)];
+        if (slot->crc != slotCrc(number, slot->value))
+            return 0;
+    }
+    return 1;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Cold start today: replay every element into an in-memory ring like Queue.c's
+static double replayUs(struct PersistentQueue* q) {
+    unsigned int capacity = INITIAL_CAPACITY, tail = 0;
+    int* items = (int*)malloc(capacity * sizeof(int));
+
+    double start = nowNs();
+    for (uint32_t i = q->header.head; i != q->header.tail; i++) {
+        if (tail == capacity) {
+            capacity *= 2;
+            items = (int*)realloc(items, capacity * sizeof(int));
+        }
+        items[tail++] = q->slots[i & (q->header.capacity - 1)].value;
+    }
+    double us = (nowNs() - start) / 1e3;
+    free(items);
+    return us;
+}
+
+void benchmark(const char* path, int n) {
+    struct PersistentQueue* q;
+
+    unlink(path);
+    q = openQueue(path, 0);
+    double start = nowNs();
+    for (int i = 0; i < n; i++)
+        enqueue(q, i);
+    printf("  %d enqueues, commit per enqueue: %.1f ns each\n", n, (nowNs() - start) / n);
+    closeQueue(q);
+
+    start = nowNs();
+    q = openQueue(path, 0);
+    double openUs = (nowNs() - start) / 1e3;
+    int front = peek(q);
+    printf("  cold start by mmap:    %10.1f us (%u elements, front %d)\n", openUs, queueSize(q), front);
+    printf("  cold start by replay:  %10.1f us\n", replayUs(q));
+    start = nowNs();
+    int ok = verifyQueue(q);
+    printf("  optional full verify:  %10.1f us (%s)\n", (nowNs() - start) / 1e3, ok ? "ok" : "CORRUPT");
+    closeQueue(q);
+
+    q = openQueue(path, 1);
+    start = nowNs();
+    for (int i = 0; i < 100; i++)
+        enqueue(q, i);
+    printf("  durable enqueues (msync per commit): %.1f us each\n", (nowNs() - start) / 100 / 1e3);
+    closeQueue(q);
+    unlink(path);
+}
+
+// Driver Code to demonstrate queue operations
+int main() {
+    const char* path = "persistent_queue.dat";
+    struct PersistentQueue* q;
+
+    unlink(path);
+    q = openQueue(path, 0);
+    enqueue(q, 10);
+    enqueue(q, 20);
+    enqueue(q, 30);
+    printf("10, 20 and 30 enqueued to queue.\n");
+    printf("Dequeued element is %d\n", dequeue(q));
+    closeQueue(q);
+
+    q = openQueue(path, 0);
+    printf("Reopened: size %u, front element is %d\n", queueSize(q), peek(q));
+
+    // Simulated crash: the slot is written but the header never committed
+    q->slots[q->header.tail & (q->header.capacity - 1)].value = 99;
+    closeQueue(q);
+    q = openQueue(path, 0);
+    printf("After a crash during enqueue(99): size %u, verify %s\n",
+           queueSize(q), verifyQueue(q) ? "ok" : "CORRUPT");
+
+    // Growth keeps FIFO order across the wrap point
+    for (int i = 0; i < 2000; i++)
+        enqueue(q, i);
+    printf("After 2000 more enqueues: size %u, capacity %u, front %d\n",
+           queueSize(q), q->header.capacity, peek(q));
+
+    // Torn header write: the newest slot is garbage, the previous commit wins
+    dequeue(q);
+    memset(headerSlot(q, (int)(q->header.sequence & 1)), 0xAB, sizeof(struct FileHeader));
+    closeQueue(q);
+    q = openQueue(path, 0);
+    printf("After a torn header write: size %u, front %d, verify %s\n",
+           queueSize(q), peek(q), verifyQueue(q) ? "ok" : "CORRUPT");
+    closeQueue(q);
+
+    printf("\nCold start with 10000000 elements:\n");
+    benchmark(path, 10000000);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    10, 20 and 30 enqueued to queue.
+    Dequeued element is 10
+    Reopened: size 2, front element is 20
+    After a crash during enqueue(99): size 2, verify ok
+    After 2000 more enqueues: size 2002, capacity 2048, front 20
+    After a torn header write: size 2002, front 20, verify ok
+
+    Cold start with 10000000 elements:
+      10000000 enqueues, commit per enqueue: 133.0 ns each
+      cold start by mmap:          58.5 us (10000000 elements, front 0)
+      cold start by replay:     46389.3 us
+      optional full verify:    163587.1 us (ok)
+      durable enqueues (msync per commit): 120.0 us each
+*/
@@ -2,35 +2,100 @@
 #include <ctype.h>   // for isdigit()
 #include <stdlib.h>  // for atoi()
 #include <string.h>  // for strlen()
+#include <time.h>    // for clock_gettime()
 
 #define SIZE 100
 
-int stack[SIZE];
-int top = -1;
+/*
+    Every call works on a caller-owned Evaluator instead of a global
+    stack[] and top, so several evaluations can run at once (one context
+    per thread). Errors no longer exit(): the evaluator stops at the first
+    bad token and returns a status, with the token's position in errorPos,
+    and the caller decides whether to skip the record or report it.
 
-// Function to push an element onto the stack
-void push(int val) {
-    if (top >= SIZE - 1) {
-        printf("Stack Overflow\n");
-        exit(1);
+    Values are 64-bit and + - * use the compiler's overflow-checked
+    builtins, so an overflow is reported instead of wrapping silently.
+*/
+
+// Result of an evaluation; EVAL_OK is 0
+enum EvalStatus {
+    EVAL_OK = 0,
+    EVAL_STACK_OVERFLOW,
+    EVAL_STACK_UNDERFLOW,
+    EVAL_DIV_ZERO,
+    EVAL_MOD_ZERO,
+    EVAL_OVERFLOW,
+    EVAL_INVALID_OPERATOR,
+    EVAL_EMPTY,
+    EVAL_TOO_MANY_OPERANDS       // More than one value left at the end
+};
+
+// Evaluation context: one per thread
+struct Evaluator {
+    long long stack[SIZE];
+    int top;
+    int errorPos;                // Offset of the token that failed, -1 if none
+};
+
+// Message for a status, the texts the old exit() paths printed
+const char* statusMessage(enum EvalStatus status) {
+    switch (status) {
+        case EVAL_OK:                return "OK";
+        case EVAL_STACK_OVERFLOW:    return "Stack Overflow";
+        case EVAL_STACK_UNDERFLOW:   return "Stack Underflow";
+        case EVAL_DIV_ZERO:          return "Division by zero error!";
+        case EVAL_MOD_ZERO:          return "Modulo by zero error!";
+        case EVAL_OVERFLOW:          return "Integer overflow";
+        case EVAL_INVALID_OPERATOR:  return "Invalid operator";
+        case EVAL_EMPTY:             return "Empty expression";
+        case EVAL_TOO_MANY_OPERANDS: return "Too many operands";
     }
-    stack[++top] = val;
+    return "Unknown error";
+}
+
+// Function to push an element onto the stack
+static inline enum EvalStatus push(struct Evaluator* ev, long long val) {
+    if (ev->top >= SIZE - 1)
+        return EVAL_STACK_OVERFLOW;
+    ev->stack[++ev->top] = val;
+    return EVAL_OK;
 }
 
 // Function to pop an element from the stack
-int pop() {
-    if (top == -1) {
-        printf("Stack Underflow\n");
-        exit(1);
+static inline enum EvalStatus pop(struct Evaluator* ev, long long* val) {
+    if (ev->top == -1)
+        return EVAL_STACK_UNDERFLOW;
+    *val = ev->stack[ev->top--];
+    return EVAL_OK;
+}
+
+// Apply one operator; + - * and the LLONG_MIN / -1 corner report overflow
+static inline enum EvalStatus applyOperator(char op, long long val1, long long val2, long long* result) {
+    switch (op) {
+        case '+': return __builtin_add_overflow(val1, val2, result) ? EVAL_OVERFLOW : EVAL_OK;
+        case '-': return __builtin_sub_overflow(val1, val2, result) ? EVAL_OVERFLOW : EVAL_OK;
+        case '*': return __builtin_mul_overflow(val1, val2, result) ? EVAL_OVERFLOW : EVAL_OK;
+        case '/':
+            if (val2 == 0) return EVAL_DIV_ZERO;
+            if (val2 == -1) return __builtin_sub_overflow(0LL, val1, result) ? EVAL_OVERFLOW : EVAL_OK;
+            *result = val1 / val2;
+            return EVAL_OK;
+        case '%':
+            if (val2 == 0) return EVAL_MOD_ZERO;
+            *result = val2 == -1 ? 0 : val1 % val2;
+            return EVAL_OK;
     }
-    return stack[top--];
+    return EVAL_INVALID_OPERATOR;
 }
 
-// Function to evaluate postfix expression
-int evaluatePostfix(char expr[]) {
+// Function to evaluate postfix expression; the value is stored in *result on EVAL_OK
+enum EvalStatus evaluatePostfix(struct Evaluator* ev, const char expr[], long long* result) {
+    enum EvalStatus status = EVAL_OK;
     int i;
     char ch;
 
+    ev->top = -1;
+    ev->errorPos = -1;
     for (i = 0; expr[i] != '\0'; i++) {
         ch = expr[i];
 
@@ -39,74 +104,153 @@ int evaluatePostfix(char expr[]) {
             continue;
 
         // If digit, convert to number and push to stack
-        if (isdigit(ch)) {
-            int num = 0;
+        if (isdigit((unsigned char)ch)) {
+            long long num = 0;
+            int start = i;
 
-            while (isdigit(expr[i])) {
-                num = num * 10 + (expr[i] - '0');
+            while (isdigit((unsigned char)expr[i])) {
+                if (__builtin_mul_overflow(num, 10, &num) ||
+                    __builtin_add_overflow(num, expr[i] - '0', &num)) {
+                    status = EVAL_OVERFLOW;
+                    i = start;
+                    break;
+                }
                 i++;
             }
+            if (status != EVAL_OK)
+                break;
             i--; // Adjust i back after overshooting
-            push(num);
+            if ((status = push(ev, num)) != EVAL_OK)
+                break;
         }
         // If operator, pop two elements and apply operation
         else {
-            int val2 = pop();
-            int val1 = pop();
-            int result;
-
-            switch (ch) {
-                case '+': result = val1 + val2; break;
-                case '-': result = val1 - val2; break;
-                case '*': result = val1 * val2; break;
-                case '/':
-                    if (val2 == 0) {
-                        printf("Division by zero error!\n");
-                        exit(1);
-                    }
-                    result = val1 / val2;
-                    break;
-                case '%':
-                    if (val2 == 0) {
-                        printf("Modulo by zero error!\n");
-                        exit(1);
-                    }
-                    result = val1 % val2;
-                    break;
-                default:
-                    printf("Invalid operator: %c\n", ch);
-                    exit(1);
-            }
+            long long val1, val2, value;
 
-            push(result);
+            if ((status = pop(ev, &val2)) != EVAL_OK ||
+                (status = pop(ev, &val1)) != EVAL_OK ||
+                (status = applyOperator(ch, val1, val2, &value)) != EVAL_OK)
+                break;
+            ev->stack[++ev->top] = value;   // Two were just popped, cannot overflow
         }
     }
 
+    if (status == EVAL_OK && ev->top == -1)
+        status = EVAL_EMPTY;
+    if (status == EVAL_OK && ev->top > 0)
+        status = EVAL_TOO_MANY_OPERANDS;
+    if (status != EVAL_OK) {
+        ev->errorPos = i;
+        return status;
+    }
     // Final result is on top
-    return pop();
+    *result = ev->stack[ev->top];
+    return EVAL_OK;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Evaluate 'count' records 'repeat' times, skipping bad ones; prints ns per record
+void benchmark(const char* label, const char* const* records, int count, int repeat) {
+    struct Evaluator ev;
+    long long sum = 0, value;
+    long skipped = 0;
+
+    double start = nowNs();
+    for (int r = 0; r < repeat; r++)
+        for (int k = 0; k < count; k++) {
+            if (evaluatePostfix(&ev, records[k], &value) == EVAL_OK)
+                sum += value;
+            else
+                skipped++;
+        }
+    double ns = (nowNs() - start) / ((double)repeat * count);
+    printf("  %-26s %6.1f ns per record, %ld skipped (sum %lld)\n", label, ns, skipped, sum);
 }
 
 // Driver Code
 int main() {
     char postfixExpr[SIZE];
+    struct Evaluator ev;
+    long long result;
 
     printf("Enter Postfix Expression (space-separated, e.g., 5 3 2 * +):\n");
-    fgets(postfixExpr, SIZE, stdin);
+    if (fgets(postfixExpr, SIZE, stdin) != NULL) {
+        // Remove newline if present
+        size_t len = strlen(postfixExpr);
+        if (len > 0 && postfixExpr[len - 1] == '\n') {
+            postfixExpr[len - 1] = '\0';
+        }
 
-    // Remove newline if present
-    size_t len = strlen(postfixExpr);
-    if (postfixExpr[len - 1] == '\n') {
-        postfixExpr[len - 1] = '\0';
+        enum EvalStatus status = evaluatePostfix(&ev, postfixExpr, &result);
+        if (status == EVAL_OK)
+            printf("Evaluated Result: %lld\n", result);
+        else
+            printf("%s at position %d\n", statusMessage(status), ev.errorPos);
     }
 
-    int result = evaluatePostfix(postfixExpr);
-    printf("Evaluated Result: %d\n", result);
+    // A batch where some records are bad: each one is reported and the loop goes on
+    const char* records[] = {
+        "5 3 2 * +",
+        "100 7 %",
+        "4 0 /",
+        "1 +",
+        "9223372036854775807 1 +",
+        "3000000000 3000000000 *",
+        "8 2 ^",
+        "99999999999999999999",
+        "",
+        "5 3",
+        "1 2 3 +",
+        "60 5 / 2 -",
+    };
+    int recordCount = (int)(sizeof(records) / sizeof(records[0]));
+    printf("\nBatch:\n");
+    for (int k = 0; k < recordCount; k++) {
+        enum EvalStatus status = evaluatePostfix(&ev, records[k], &result);
+        if (status == EVAL_OK)
+            printf("  %-26s = %lld\n", records[k], result);
+        else
+            printf("  %-26s skipped: %s at position %d\n", records[k], statusMessage(status), ev.errorPos);
+    }
 
+    const char* valid[] = {"12 34 + 5 *", "100 7 % 3 -", "9 8 7 6 + - *", "60 5 / 2 -"};
+    const char* mixed[] = {"12 34 + 5 *", "4 0 /", "9 8 7 6 + - *", "1 +"};
+    const char* malformed[] = {"+ 1 2", "7 0 %", "1 2 &", "x"};
+    printf("\n10000000 records per row:\n");
+    benchmark("all valid", valid, 4, 2500000);
+    benchmark("half malformed", mixed, 4, 2500000);
+    benchmark("all malformed", malformed, 4, 2500000);
     return 0;
 }
 
 /*
-    Output:
+    Output (timings depend on the machine):
     --------------------------------
-    
-*/
\ No newline at end of file
+    Enter Postfix Expression (space-separated, e.g., 5 3 2 * +):
+    Evaluated Result: 11
+
+    Batch:
+      5 3 2 * +                  = 11
+      100 7 %                    = 2
+      4 0 /                      skipped: Division by zero error! at position 4
+      1 +                        skipped: Stack Underflow at position 2
+      9223372036854775807 1 +    skipped: Integer overflow at position 22
+      3000000000 3000000000 *    = 9000000000000000000
+      8 2 ^                      skipped: Invalid operator at position 4
+      99999999999999999999       skipped: Integer overflow at position 0
+                                 skipped: Empty expression at position 0
+      5 3                        skipped: Too many operands at position 3
+      1 2 3 +                    skipped: Too many operands at position 7
+      60 5 / 2 -                 = 10
+
+    10000000 records per row:
+      all valid                    62.4 ns per record, 0 skipped (sum 485000000)
+      half malformed               52.3 ns per record, 5000000 skipped (sum 462500000)
+      all malformed                24.2 ns per record, 10000000 skipped (sum 0)
+*/
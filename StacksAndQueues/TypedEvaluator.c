@@ -0,0 +1,528 @@
+#include <stdio.h>
+#include <stdlib.h>     // for strtod()
+#include <string.h>     // for strlen()
+#include <limits.h>     // for LLONG_MIN, LLONG_MAX
+#include <math.h>       // for isfinite(), fmod()
+#include <time.h>       // for clock_gettime()
+
+#define SIZE 100             // Stack slots per evaluator
+#define FIXED_SCALE 10000    // Fixed-point values are in units of 1/10000
+#define FIXED_DIGITS 4
+
+/*
+    Postfix evaluation in three number types from one loop.
+
+    PostfixEvaluation.c works on long long only. Here the same loop is
+    written once in PostfixKernel.h and included three times:
+
+        Int64    long long, + - * / % overflow-checked, no decimal point
+        Double   double, division by zero and overflow to inf reported,
+                 % is fmod()
+        Fixed    decimal fixed point for money: a long long counting
+                 1/10000ths, so 19.99 is exactly 199900. Products and
+                 quotients round half away from zero to 4 decimals, as
+                 accounting code expects, and fall back to 128 bits
+                 only when the intermediate does not fit in 64. % is
+                 the exact remainder of the scaled units, so
+                 7.5 % 2 is 1.5.
+
+    Each inclusion is its own function with its type's parse/add/sub/mul/
+    div/mod inlined, so the hot loop never asks which type it is working on.
+    evaluateTagged() is the alternative for comparison: one loop over a
+    union that switches on the type at every number and every operator.
+*/
+
+// Result of an evaluation; EVAL_OK is 0
+enum EvalStatus {
+    EVAL_OK = 0,
+    EVAL_STACK_OVERFLOW,
+    EVAL_STACK_UNDERFLOW,
+    EVAL_DIV_ZERO,
+    EVAL_MOD_ZERO,
+    EVAL_OVERFLOW,
+    EVAL_INVALID_NUMBER,
+    EVAL_INVALID_OPERATOR,
+    EVAL_EMPTY,
+    EVAL_TOO_MANY_OPERANDS       // More than one value left at the end
+};
+
+const char* statusMessage(enum EvalStatus status) {
+    switch (status) {
+        case EVAL_OK:                return "OK";
+        case EVAL_STACK_OVERFLOW:    return "Stack Overflow";
+        case EVAL_STACK_UNDERFLOW:   return "Stack Underflow";
+        case EVAL_DIV_ZERO:          return "Division by zero error!";
+        case EVAL_MOD_ZERO:          return "Modulo by zero error!";
+        case EVAL_OVERFLOW:          return "Overflow";
+        case EVAL_INVALID_NUMBER:    return "Invalid number";
+        case EVAL_INVALID_OPERATOR:  return "Invalid operator";
+        case EVAL_EMPTY:             return "Empty expression";
+        case EVAL_TOO_MANY_OPERANDS: return "Too many operands";
+    }
+    return "Unknown error";
+}
+
+/* ---- long long ---- */
+
+static inline enum EvalStatus parseInt64(const char* s, int* i, long long* value) {
+    long long num = 0;
+    int k = *i;
+    for (; s[k] >= '0' && s[k] <= '9'; k++)
+        if (__builtin_mul_overflow(num, 10, &num) || __builtin_add_overflow(num, s[k] - '0', &num))
+            return EVAL_OVERFLOW;
+    if (s[k] == '.' || k == *i)
+        return EVAL_INVALID_NUMBER;
+    *i = k - 1;
+    *value = num;
+    return EVAL_OK;
+}
+
+static inline enum EvalStatus addInt64(long long a, long long b, long long* result) {
+    return __builtin_add_overflow(a, b, result) ? EVAL_OVERFLOW : EVAL_OK;
+}
+
+static inline enum EvalStatus subInt64(long long a, long long b, long long* result) {
+    return __builtin_sub_overflow(a, b, result) ? EVAL_OVERFLOW : EVAL_OK;
+}
+
+static inline enum EvalStatus mulInt64(long long a, long long b, long long* result) {
+    return __builtin_mul_overflow(a, b, result) ? EVAL_OVERFLOW : EVAL_OK;
+}
+
+static inline enum EvalStatus divInt64(long long a, long long b, long long* result) {
+    if (b == 0) return EVAL_DIV_ZERO;
+    if (b == -1 && a == LLONG_MIN) return EVAL_OVERFLOW;
+    *result = a / b;
+    return EVAL_OK;
+}
+
+static inline enum EvalStatus modInt64(long long a, long long b, long long* result) {
+    if (b == 0) return EVAL_MOD_ZERO;
+    *result = b == -1 ? 0 : a % b;     // LLONG_MIN % -1 traps on x86
+    return EVAL_OK;
+}
+
+/* ---- double ---- */
+
+// Powers of ten up to 1e22 are exact doubles
+static const double powersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Up to 15 significant digits the mantissa and the power of ten are exact,
+// so one division rounds correctly; longer numbers go through strtod()
+static inline enum EvalStatus parseDouble(const char* s, int* i, double* value) {
+    unsigned long long mantissa = 0;
+    int k = *i, digits = 0, fraction = -1;
+    for (;; k++) {
+        if (s[k] >= '0' && s[k] <= '9') {
+            mantissa = mantissa * 10 + (s[k] - '0');
+            digits++;
+            if (fraction >= 0) fraction++;
+        } else if (s[k] == '.' && fraction < 0) {
+            fraction = 0;
+        } else {
+            break;
+        }
+    }
+    if (digits == 0 || s[k] == '.')
+        return EVAL_INVALID_NUMBER;
+    if (digits <= 15)
+        *value = fraction > 0 ? (double)mantissa / powersOfTen[fraction] : (double)mantissa;
+    else
+        *value = strtod(s + *i, NULL);
+    *i = k - 1;
+    return EVAL_OK;
+}
+
+static inline enum EvalStatus addDouble(double a, double b, double* result) {
+    *result = a + b;
+    return isfinite(*result) ? EVAL_OK : EVAL_OVERFLOW;
+}
+
+static inline enum EvalStatus subDouble(double a, double b, double* result) {
+    *result = a - b;
+    return isfinite(*result) ? EVAL_OK : EVAL_OVERFLOW;
+}
+
+static inline enum EvalStatus mulDouble(double a, double b, double* result) {
+    *result = a * b;
+    return isfinite(*result) ? EVAL_OK : EVAL_OVERFLOW;
+}
+
+static inline enum EvalStatus divDouble(double a, double b, double* result) {
+    if (b == 0) return EVAL_DIV_ZERO;
+    *result = a / b;
+    return isfinite(*result) ? EVAL_OK : EVAL_OVERFLOW;
+}
+
+// fmod() is exact, and finite for finite operands
+static inline enum EvalStatus modDouble(double a, double b, double* result) {
+    if (b == 0) return EVAL_MOD_ZERO;
+    *result = fmod(a, b);
+    return EVAL_OK;
+}
+
+/* ---- decimal fixed point ---- */
+
+typedef long long Fixed;
+
+// Digits past the fourth decimal round half up
+static inline enum EvalStatus parseFixed(const char* s, int* i, Fixed* value) {
+    long long units = 0, fraction = 0;
+    int k = *i, digits = 0;
+    for (; s[k] >= '0' && s[k] <= '9'; k++, digits++)
+        if (units > (LLONG_MAX / FIXED_SCALE - 9) / 10)
+            return EVAL_OVERFLOW;
+        else
+            units = units * 10 + (s[k] - '0');
+    if (s[k] == '.') {
+        int places = 0;
+        for (k++; s[k] >= '0' && s[k] <= '9'; k++, digits++, places++) {
+            if (places < FIXED_DIGITS)
+                fraction = fraction * 10 + (s[k] - '0');
+            else if (places == FIXED_DIGITS && s[k] >= '5')
+                fraction++;
+        }
+        for (; places < FIXED_DIGITS; places++)
+            fraction *= 10;
+    }
+    if (digits == 0 || s[k] == '.')
+        return EVAL_INVALID_NUMBER;
+    *i = k - 1;
+    *value = units * FIXED_SCALE + fraction;
+    return EVAL_OK;
+}
+
+static inline enum EvalStatus addFixed(Fixed a, Fixed b, Fixed* result) {
+    return __builtin_add_overflow(a, b, result) ? EVAL_OVERFLOW : EVAL_OK;
+}
+
+static inline enum EvalStatus subFixed(Fixed a, Fixed b, Fixed* result) {
+    return __builtin_sub_overflow(a, b, result) ? EVAL_OVERFLOW : EVAL_OK;
+}
+
+// n / d rounded half away from zero
+static inline long long roundedQuotient(long long n, long long d) {
+    long long q = n / d, r = n % d;
+    unsigned long long ur = r < 0 ? 0ull - (unsigned long long)r : (unsigned long long)r;
+    unsigned long long ud = d < 0 ? 0ull - (unsigned long long)d : (unsigned long long)d;
+    if (ur >= ud - ur)
+        q += (n < 0) != (d < 0) ? -1 : 1;
+    return q;
+}
+
+// The same through 128 bits, for intermediates past 64 bits; fails if the quotient does not fit
+static inline enum EvalStatus roundedQuotientWide(__int128 n, __int128 d, Fixed* result) {
+    __int128 q = n / d, r = n % d;
+    if (2 * (r < 0 ? -r : r) >= (d < 0 ? -d : d))
+        q += (n < 0) != (d < 0) ? -1 : 1;
+    if (q > LLONG_MAX || q < LLONG_MIN)
+        return EVAL_OVERFLOW;
+    *result = (Fixed)q;
+    return EVAL_OK;
+}
+
+// Most products fit in 64 bits, where dividing by the constant scale is a multiply
+static inline enum EvalStatus mulFixed(Fixed a, Fixed b, Fixed* result) {
+    long long product;
+    if (__builtin_mul_overflow(a, b, &product))
+        return roundedQuotientWide((__int128)a * b, FIXED_SCALE, result);
+    *result = roundedQuotient(product, FIXED_SCALE);
+    return EVAL_OK;
+}
+
+static inline enum EvalStatus divFixed(Fixed a, Fixed b, Fixed* result) {
+    long long scaled;
+    if (b == 0) return EVAL_DIV_ZERO;
+    if (__builtin_mul_overflow(a, (long long)FIXED_SCALE, &scaled) || (scaled == LLONG_MIN && b == -1))
+        return roundedQuotientWide((__int128)a * FIXED_SCALE, b, result);
+    *result = roundedQuotient(scaled, b);
+    return EVAL_OK;
+}
+
+// Both operands count the same 1/10000ths, so the remainder of the units is exact
+static inline enum EvalStatus modFixed(Fixed a, Fixed b, Fixed* result) {
+    if (b == 0) return EVAL_MOD_ZERO;
+    *result = b == -1 ? 0 : a % b;
+    return EVAL_OK;
+}
+
+// Write a Fixed as a decimal with all four places
+static void formatFixed(Fixed value, char* out) {
+    unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long)value : (unsigned long long)value;
+    sprintf(out, "%s%llu.%0*llu", value < 0 ? "-" : "", magnitude / FIXED_SCALE,
+            FIXED_DIGITS, magnitude % FIXED_SCALE);
+}
+
+/* ---- one evaluator per type ---- */
+
+#define KERNEL_STACK SIZE
+
+#define KERNEL_TYPE long long
+#define KERNEL_NAME Int64
+#include "PostfixKernel.h"
+
+#define KERNEL_TYPE double
+#define KERNEL_NAME Double
+#include "PostfixKernel.h"
+
+#define KERNEL_TYPE Fixed
+#define KERNEL_NAME Fixed
+#include "PostfixKernel.h"
+
+/* ---- the dispatching alternative ---- */
+
+enum NumType { NUM_INT64, NUM_DOUBLE, NUM_FIXED };
+
+union Number {
+    long long i;                 // NUM_INT64 and NUM_FIXED
+    double d;
+};
+
+struct TaggedEvaluator {
+    union Number stack[SIZE];
+    int top;
+    int errorPos;
+};
+
+// The same loop as PostfixKernel.h, deciding the type at every number and operator
+enum EvalStatus evaluateTagged(struct TaggedEvaluator* ev, enum NumType type, const char* expr, union Number* result) {
+    union Number* stack = ev->stack;
+    enum EvalStatus status = EVAL_OK;
+    int top = -1, i;
+
+    for (i = 0; expr[i] != '\0'; i++) {
+        char ch = expr[i];
+
+        if (ch == ' ' || ch == '\n')
+            continue;
+        if ((ch >= '0' && ch <= '9') || ch == '.') {
+            union Number value = {0};
+            if (top == SIZE - 1) {
+                status = EVAL_STACK_OVERFLOW;
+                break;
+            }
+            switch (type) {
+                case NUM_INT64:  status = parseInt64(expr, &i, &value.i); break;
+                case NUM_DOUBLE: status = parseDouble(expr, &i, &value.d); break;
+                case NUM_FIXED:  status = parseFixed(expr, &i, &value.i); break;
+            }
+            if (status != EVAL_OK)
+                break;
+            stack[++top] = value;
+        } else {
+            if (top < 1) {
+                status = EVAL_STACK_UNDERFLOW;
+                break;
+            }
+            union Number* a = &stack[top - 1];
+            union Number b = stack[top];
+            switch (type) {
+                case NUM_INT64:
+                    switch (ch) {
+                        case '+': status = addInt64(a->i, b.i, &a->i); break;
+                        case '-': status = subInt64(a->i, b.i, &a->i); break;
+                        case '*': status = mulInt64(a->i, b.i, &a->i); break;
+                        case '/': status = divInt64(a->i, b.i, &a->i); break;
+                        case '%': status = modInt64(a->i, b.i, &a->i); break;
+                        default:  status = EVAL_INVALID_OPERATOR; break;
+                    }
+                    break;
+                case NUM_DOUBLE:
+                    switch (ch) {
+                        case '+': status = addDouble(a->d, b.d, &a->d); break;
+                        case '-': status = subDouble(a->d, b.d, &a->d); break;
+                        case '*': status = mulDouble(a->d, b.d, &a->d); break;
+                        case '/': status = divDouble(a->d, b.d, &a->d); break;
+                        case '%': status = modDouble(a->d, b.d, &a->d); break;
+                        default:  status = EVAL_INVALID_OPERATOR; break;
+                    }
+                    break;
+                case NUM_FIXED:
+                    switch (ch) {
+                        case '+': status = addFixed(a->i, b.i, &a->i); break;
+                        case '-': status = subFixed(a->i, b.i, &a->i); break;
+                        case '*': status = mulFixed(a->i, b.i, &a->i); break;
+                        case '/': status = divFixed(a->i, b.i, &a->i); break;
+                        case '%': status = modFixed(a->i, b.i, &a->i); break;
+                        default:  status = EVAL_INVALID_OPERATOR; break;
+                    }
+                    break;
+            }
+            if (status != EVAL_OK)
+                break;
+            top--;
+        }
+    }
+
+    ev->top = top;
+    ev->errorPos = -1;
+    if (status == EVAL_OK && top == -1)
+        status = EVAL_EMPTY;
+    if (status == EVAL_OK && top > 0)
+        status = EVAL_TOO_MANY_OPERANDS;
+    if (status != EVAL_OK) {
+        ev->errorPos = i;
+        return status;
+    }
+    *result = stack[top];
+    return EVAL_OK;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Evaluate 'count' records 'repeat' times in one type, typed or tagged; returns ns per record
+double timeRecords(enum NumType type, int tagged, const char* const* records, int count, int repeat,
+                   long* skipped, double* checksum) {
+    struct Int64Evaluator int64Ev;
+    struct DoubleEvaluator doubleEv;
+    struct FixedEvaluator fixedEv;
+    struct TaggedEvaluator taggedEv;
+    long long i64;
+    double d;
+    union Number n;
+    double sum = 0;
+
+    *skipped = 0;
+    double start = nowNs();
+    for (int r = 0; r < repeat; r++)
+        for (int k = 0; k < count; k++) {
+            enum EvalStatus status;
+            if (tagged) {
+                status = evaluateTagged(&taggedEv, type, records[k], &n);
+                if (status == EVAL_OK) sum += type == NUM_DOUBLE ? n.d : (double)n.i;
+            } else if (type == NUM_INT64) {
+                status = evaluateInt64(&int64Ev, records[k], &i64);
+                if (status == EVAL_OK) sum += (double)i64;
+            } else if (type == NUM_DOUBLE) {
+                status = evaluateDouble(&doubleEv, records[k], &d);
+                if (status == EVAL_OK) sum += d;
+            } else {
+                status = evaluateFixed(&fixedEv, records[k], &i64);
+                if (status == EVAL_OK) sum += (double)i64;
+            }
+            if (status != EVAL_OK)
+                (*skipped)++;
+        }
+    *checksum = sum;
+    return (nowNs() - start) / ((double)repeat * count);
+}
+
+// One row of the matrix: every type, typed and tagged, best of 'trials' runs each.
+// All records of a run share one type, so the tagged loop's type switch is
+// always predicted; what it still pays for is the extra branch per token,
+// and loop alignment can move either column by as much.
+void benchmark(const char* label, const char* const* records, int count, int repeat, int trials) {
+    printf("  %-20s", label);
+    for (int type = NUM_INT64; type <= NUM_FIXED; type++) {
+        long skippedTyped = 0, skippedTagged = 0;
+        double sumTyped = 0, sumTagged = 0, typed = 1e30, taggedNs = 1e30;
+        for (int t = 0; t < trials; t++) {
+            double ns = timeRecords((enum NumType)type, 0, records, count, repeat, &skippedTyped, &sumTyped);
+            if (ns < typed) typed = ns;
+            ns = timeRecords((enum NumType)type, 1, records, count, repeat, &skippedTagged, &sumTagged);
+            if (ns < taggedNs) taggedNs = ns;
+        }
+        if (skippedTyped == (long)count * repeat)
+            printf(" %17s", "rejected");
+        else
+            printf(" %7.1f / %7.1f%s", typed, taggedNs,
+                   sumTyped == sumTagged && skippedTyped == skippedTagged ? "" : "!");
+    }
+    printf("\n");
+}
+
+// Print one record in all three types
+void demo(const char* expr) {
+    struct Int64Evaluator int64Ev;
+    struct DoubleEvaluator doubleEv;
+    struct FixedEvaluator fixedEv;
+    long long i64;
+    double d;
+    Fixed f;
+    char text[48];
+    enum EvalStatus status;
+
+    printf("%-24s", expr);
+    status = evaluateInt64(&int64Ev, expr, &i64);
+    if (status == EVAL_OK) sprintf(text, "%lld", i64);
+    else sprintf(text, "%s", statusMessage(status));
+    printf(" %-24s", text);
+    status = evaluateDouble(&doubleEv, expr, &d);
+    if (status == EVAL_OK) sprintf(text, "%.17g", d);
+    else sprintf(text, "%s", statusMessage(status));
+    printf(" %-24s", text);
+    status = evaluateFixed(&fixedEv, expr, &f);
+    if (status == EVAL_OK) formatFixed(f, text);
+    else sprintf(text, "%s", statusMessage(status));
+    printf(" %s\n", text);
+}
+
+// Driver Code
+int main() {
+    printf("%-24s %-24s %-24s %s\n", "Expression", "int64", "double", "fixed (4 places)");
+    demo("5 3 2 * +");
+    demo("7 2 /");
+    demo("0.1 0.2 +");
+    demo("19.99 3 * 0.0825 *");
+    demo("100 3 / 3 *");
+    demo("4 0 /");
+    demo("9223372036854775807 1 +");
+    demo("2.5 4 *");
+    demo("17 5 %");
+    demo("7.5 2 %");
+    demo("5 3");
+
+    // Long chains stay bounded: each "k *" is undone by a later "k /"
+    static char chains[4][1024];
+    const char* chainRecords[4];
+    unsigned int seed = 7;
+    for (int c = 0; c < 4; c++) {
+        int len = sprintf(chains[c], "%d", 100 + c);
+        for (int t = 0; t < 50; t++) {
+            seed = seed * 1103515245u + 12345u;
+            int k = 1 + (seed >> 8) % 9;
+            len += sprintf(chains[c] + len, " %d + %d * %d - %d /", k, k, k + 1, k);
+        }
+        chainRecords[c] = chains[c];
+    }
+
+    const char* integers[] = {"12 34 + 5 *", "100 7 - 3 *", "9 8 7 6 + - *", "60 5 / 2 -"};
+    const char* prices[] = {"19.99 3 * 0.0825 *", "4.50 2 * 1.25 +", "100 0.15 * 3 /", "2.5 2.5 * 1.1 -"};
+    printf("\nns per record, one loop per type / one loop switching on the type:\n");
+    printf("  %-20s %17s %17s %17s\n", "", "int64", "double", "fixed");
+    benchmark("integer formulas", integers, 4, 500000, 7);
+    benchmark("decimal prices", prices, 4, 500000, 7);
+    benchmark("200-operator chains", chainRecords, 4, 10000, 7);
+    return 0;
+}
+
+/*
+    Output (timings depend on the machine):
+    -------------------------
+    Expression               int64                    double                   fixed (4 places)
+    5 3 2 * +                11                       11                       11.0000
+    7 2 /                    3                        3.5                      3.5000
+    0.1 0.2 +                Invalid number           0.30000000000000004      0.3000
+    19.99 3 * 0.0825 *       Invalid number           4.9475249999999997       4.9475
+    100 3 / 3 *              99                       100                      99.9999
+    4 0 /                    Division by zero error!  Division by zero error!  Division by zero error!
+    9223372036854775807 1 +  Overflow                 9.2233720368547758e+18   Overflow
+    2.5 4 *                  Invalid number           10                       10.0000
+    17 5 %                   2                        2                        2.0000
+    7.5 2 %                  Invalid number           1.5                      1.5000
+    5 3                      Too many operands        Too many operands        Too many operands
+
+    ns per record, one loop per type / one loop switching on the type:
+                                       int64            double             fixed
+      integer formulas        31.9 /    32.5    42.1 /    51.0    45.4 /    43.6
+      decimal prices                rejected    38.2 /    45.5    43.0 /    47.2
+      200-operator chains   2582.8 /  2949.5  2941.3 /  3487.0  3047.3 /  3503.4
+*/
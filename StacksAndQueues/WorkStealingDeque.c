@@ -0,0 +1,350 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>  // for atomic_thread_fence() and atomic_compare_exchange_strong_explicit()
+#include <pthread.h>    // for pthread_create()
+#include <sched.h>      // for sched_yield()
+#include <unistd.h>     // for sysconf()
+#include <time.h>       // for clock_gettime()
+
+#define INITIAL_CAPACITY 64   // Starting deque capacity, must be a power of two
+#define MAX_WORKERS 64
+#define FIB_N 34              // Benchmark: fib(FIB_N)
+#define FIB_CUTOFF 18         // Below this fib runs serially
+#define SUM_N 100000000L      // Benchmark: sum of SUM_N array elements
+#define SUM_CUTOFF 65536L     // Below this range size sum runs serially
+
+struct Task;
+
+/*
+    Chase-Lev work-stealing deque.
+
+    The owner thread works at the bottom end like push()/pop() in stacks.c
+    (LIFO, so it keeps running the freshest and most cache-warm task). Other
+    threads steal from the top end like dequeue() in Queue.c (FIFO, so they
+    take the oldest and usually largest piece of work). Only the owner moves
+    bottom and thieves race for top with a CAS; the only conflict between
+    owner and thieves is over the last element, resolved by the same CAS.
+
+    When the ring is full the owner copies it into one twice as big. Thieves
+    may still be reading the old ring, so it is kept on a retired list and
+    freed with the deque.
+*/
+struct DequeArray {
+    long capacity;             // Power of two
+    struct DequeArray* retired;
+    _Atomic(struct Task*) items[];
+};
+
+struct Deque {
+    _Alignas(64) atomic_long top;      // Next index to steal
+    _Alignas(64) atomic_long bottom;   // Next index to push
+    _Atomic(struct DequeArray*) array;
+};
+
+static struct DequeArray* createArray(long capacity) {
+    struct DequeArray* a = (struct DequeArray*)malloc(sizeof(struct DequeArray) +
+                                                      capacity * sizeof(_Atomic(struct Task*)));
+    if (a == NULL) {
+        printf("Out of memory growing deque\n");
+        exit(1);
+    }
+    a->capacity = capacity;
+    a->retired = NULL;
+    return a;
+}
+
+void initDeque(struct Deque* d) {
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    atomic_init(&d->array, createArray(INITIAL_CAPACITY));
+}
+
+void destroyDeque(struct Deque* d) {
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    while (a != NULL) {
+        struct DequeArray* older = a->retired;
+        free(a);
+        a = older;
+    }
+}
+
+// Owner only: copy live elements into a ring twice as big
+static struct DequeArray* growDeque(struct Deque* d, struct DequeArray* old, long top, long bottom) {
+    struct DequeArray* a = createArray(old->capacity * 2);
+    for (long i = top; i < bottom; i++)
+        atomic_store_explicit(&a->items[i & (a->capacity - 1)],
+                              atomic_load_explicit(&old->items[i & (old->capacity - 1)], memory_order_relaxed),
+                              memory_order_relaxed);
+    a->retired = old;
+    atomic_store_explicit(&d->array, a, memory_order_release);
+    return a;
+}
+
+// Owner: push a task at the bottom
+void pushBottom(struct Deque* d, struct Task* t) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&d->top, memory_order_acquire);
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+
+    if (b - top > a->capacity - 1)
+        a = growDeque(d, a, top, b);
+    atomic_store_explicit(&a->items[b & (a->capacity - 1)], t, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+}
+
+// Owner: pop the newest task from the bottom, NULL if empty
+struct Task* popBottom(struct Deque* d) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        // Deque was empty
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+    struct Task* task = atomic_load_explicit(&a->items[b & (a->capacity - 1)], memory_order_relaxed);
+    if (t == b) {
+        // Last element: race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed))
+            task = NULL;
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Thief: take the oldest task from the top, NULL if empty or another thread won
+struct Task* steal(struct Deque* d) {
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+    if (t >= b)
+        return NULL;
+    struct DequeArray* a = atomic_load_explicit(&d->array, memory_order_acquire);
+    struct Task* task = atomic_load_explicit(&a->items[t & (a->capacity - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+    return task;
+}
+
+/*
+    Fork/join scheduler.
+
+    Each worker owns one deque. spawnTask() pushes a child task on the
+    caller's deque; syncTask() runs other work (own deque first, then
+    stealing) until the child is done, so a worker never blocks. Tasks live in their parent's
+    stack frame, which stays alive because the parent syncs before returning.
+*/
+struct Task {
+    void (*run)(struct Task*);
+    atomic_int done;
+};
+
+struct Worker {
+    pthread_t thread;
+    int id;
+    unsigned int seed;
+    struct Deque deque;
+};
+
+static struct Worker workers[MAX_WORKERS];
+static int workerCount;
+static atomic_int stopWorkers;
+static _Thread_local struct Worker* self;
+
+static void runTask(struct Task* t) {
+    t->run(t);
+    atomic_store_explicit(&t->done, 1, memory_order_release);
+}
+
+// Try to steal one task from a random victim
+static struct Task* stealAny(void) {
+    if (workerCount < 2)
+        return NULL;
+    self->seed = self->seed * 1103515245u + 12345u;
+    int victim = (int)((self->seed >> 16) % (workerCount - 1));
+    if (victim >= self->id) victim++;
+    return steal(&workers[victim].deque);
+}
+
+void spawnTask(struct Task* t, void (*run)(struct Task*)) {
+    t->run = run;
+    atomic_init(&t->done, 0);
+    pushBottom(&self->deque, t);
+}
+
+void syncTask(struct Task* t) {
+    while (!atomic_load_explicit(&t->done, memory_order_acquire)) {
+        struct Task* other = popBottom(&self->deque);
+        if (other == NULL)
+            other = stealAny();
+        if (other != NULL)
+            runTask(other);
+        else
+            sched_yield();
+    }
+}
+
+static void* workerLoop(void* arg) {
+    self = (struct Worker*)arg;
+    while (!atomic_load_explicit(&stopWorkers, memory_order_acquire)) {
+        struct Task* t = popBottom(&self->deque);
+        if (t == NULL)
+            t = stealAny();
+        if (t != NULL)
+            runTask(t);
+        else
+            sched_yield();
+    }
+    return NULL;
+}
+
+// Start 'count' workers; the calling thread becomes worker 0
+void startScheduler(int count) {
+    workerCount = count;
+    atomic_store(&stopWorkers, 0);
+    for (int i = 0; i < count; i++) {
+        workers[i].id = i;
+        workers[i].seed = 2654435761u * (i + 1);
+        initDeque(&workers[i].deque);
+    }
+    self = &workers[0];
+    for (int i = 1; i < count; i++)
+        pthread_create(&workers[i].thread, NULL, workerLoop, &workers[i]);
+}
+
+void stopScheduler(void) {
+    atomic_store(&stopWorkers, 1);
+    for (int i = 1; i < workerCount; i++)
+        pthread_join(workers[i].thread, NULL);
+    for (int i = 0; i < workerCount; i++)
+        destroyDeque(&workers[i].deque);
+}
+
+// Parallel fib: spawn fib(n-1), compute fib(n-2) inline, then join
+struct FibTask {
+    struct Task task;   // Must be first
+    int n;
+    long result;
+};
+
+static long fibSerial(int n) {
+    return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+static void fibRun(struct Task* t) {
+    struct FibTask* f = (struct FibTask*)t;
+    if (f->n < FIB_CUTOFF) {
+        f->result = fibSerial(f->n);
+        return;
+    }
+    struct FibTask left = {.n = f->n - 1};
+    struct FibTask right = {.n = f->n - 2};
+    spawnTask(&left.task, fibRun);
+    fibRun(&right.task);
+    syncTask(&left.task);
+    f->result = left.result + right.result;
+}
+
+// Parallel sum: split the range in halves until it is small enough
+struct SumTask {
+    struct Task task;   // Must be first
+    const int* data;
+    long from, to;
+    long long result;
+};
+
+static void sumRun(struct Task* t) {
+    struct SumTask* s = (struct SumTask*)t;
+    if (s->to - s->from <= SUM_CUTOFF) {
+        long long sum = 0;
+        for (long i = s->from; i < s->to; i++)
+            sum += s->data[i];
+        s->result = sum;
+        return;
+    }
+    long mid = s->from + (s->to - s->from) / 2;
+    struct SumTask left = {.data = s->data, .from = s->from, .to = mid};
+    struct SumTask right = {.data = s->data, .from = mid, .to = s->to};
+    spawnTask(&left.task, sumRun);
+    sumRun(&right.task);
+    syncTask(&left.task);
+    s->result = left.result + right.result;
+}
+
+// Current time in nanoseconds (monotonic clock)
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Driver Code: optional argument is the highest worker count to benchmark
+int main(int argc, char* argv[]) {
+    int maxWorkers = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    double fibBase = 0, sumBase = 0;
+
+    if (maxWorkers < 1) maxWorkers = 1;
+    if (maxWorkers > MAX_WORKERS) maxWorkers = MAX_WORKERS;
+
+    // Single-threaded walk through the deque: bottom is LIFO, top is FIFO
+    struct Deque d;
+    struct Task tasks[100];
+    initDeque(&d);
+    for (int i = 0; i < 100; i++)
+        pushBottom(&d, &tasks[i]);   // Grows past INITIAL_CAPACITY
+    printf("popBottom gives task %ld, steal gives task %ld\n",
+           (long)(popBottom(&d) - tasks), (long)(steal(&d) - tasks));
+    destroyDeque(&d);
+
+    int* data = (int*)malloc(SUM_N * sizeof(int));
+    for (long i = 0; i < SUM_N; i++)
+        data[i] = (int)(i % 1000);
+
+    printf("\nworkers    fib(%d)  speedup     sum(1e8)  speedup\n", FIB_N);
+    for (int w = 1;; w = w * 2 < maxWorkers ? w * 2 : maxWorkers) {
+        startScheduler(w);
+
+        struct FibTask fib = {.n = FIB_N};
+        double start = nowNs();
+        fibRun(&fib.task);
+        double fibTime = (nowNs() - start) / 1e6;
+
+        struct SumTask sum = {.data = data, .from = 0, .to = SUM_N};
+        start = nowNs();
+        sumRun(&sum.task);
+        double sumTime = (nowNs() - start) / 1e6;
+
+        stopScheduler();
+
+        if (w == 1) {
+            fibBase = fibTime;
+            sumBase = sumTime;
+        }
+        printf("%7d  %7.1f ms  %6.2fx  %8.1f ms  %6.2fx   (fib=%ld sum=%lld)\n", w,
+               fibTime, fibBase / fibTime, sumTime, sumBase / sumTime, fib.result, sum.result);
+        if (w == maxWorkers)
+            break;
+    }
+
+    free(data);
+    return 0;
+}
+
+/*
+    Output (numbers depend on the machine and core count):
+    --------------------------------
+    popBottom gives task 99, steal gives task 0
+
+    workers    fib(34)  speedup     sum(1e8)  speedup
+          1     22.4 ms    1.00x      91.1 ms    1.00x   (fib=5702887 sum=49950000000)
+          2     21.4 ms    1.05x      95.1 ms    0.96x   (fib=5702887 sum=49950000000)
+          4     25.0 ms    0.89x     101.3 ms    0.90x   (fib=5702887 sum=49950000000)
+    (measured on a single-core machine, so there is no speedup to show here)
+*/